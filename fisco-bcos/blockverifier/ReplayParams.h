@@ -0,0 +1,105 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+
+/**
+ * @brief : params of the block replay benchmark
+ */
+#pragma once
+#include <boost/program_options.hpp>
+#include <iostream>
+#include <string>
+
+class ReplayParams
+{
+public:
+    ReplayParams(boost::program_options::variables_map const& vm)
+    {
+        m_dataPath = vm["data"].as<std::string>();
+        m_statePath = vm.count("state") ? vm["state"].as<std::string>() : m_dataPath;
+        m_workPath = vm["work"].as<std::string>();
+        m_from = vm["from"].as<int64_t>();
+        m_to = vm["to"].as<int64_t>();
+        m_stateType = vm["stateType"].as<std::string>();
+        m_parallelThreads = vm["parallelThreads"].as<unsigned>();
+        m_profile = vm.count("profile") > 0;
+    }
+
+    /// the data directory of the group whose blocks are replayed
+    std::string const& dataPath() const { return m_dataPath; }
+    /// the data directory holding the state the first replayed block is executed on
+    std::string const& statePath() const { return m_statePath; }
+    /// the state is copied to it, and the replayed blocks are committed to the copy
+    std::string const& workPath() const { return m_workPath; }
+    int64_t from() const { return m_from; }
+    /// -1 to replay until the last block
+    int64_t to() const { return m_to; }
+    std::string const& stateType() const { return m_stateType; }
+    unsigned parallelThreads() const { return m_parallelThreads; }
+    bool profile() const { return m_profile; }
+
+private:
+    std::string m_dataPath;
+    std::string m_statePath;
+    std::string m_workPath;
+    int64_t m_from;
+    int64_t m_to;
+    std::string m_stateType;
+    unsigned m_parallelThreads;
+    bool m_profile;
+};
+
+static ReplayParams initCommandLine(int argc, const char* argv[])
+{
+    namespace po = boost::program_options;
+    po::options_description replay_options(
+        "Replay the blocks of a group on a copy of their pre-state, verify their roots and report "
+        "the execution time");
+    auto options = replay_options.add_options();
+    options("data,d", po::value<std::string>(),
+        "data directory of the group whose blocks are replayed");
+    options("state,s", po::value<std::string>(),
+        "data directory holding the state of the block before --from, default is --data, which "
+        "only holds the state of the last block with the storage state");
+    options("work,w", po::value<std::string>()->default_value("replay_data"),
+        "the state is copied to this new directory, and the replayed blocks are committed to it");
+    options("from,f", po::value<int64_t>()->default_value(1), "the first replayed block");
+    options("to,t", po::value<int64_t>()->default_value(-1),
+        "the last replayed block, default is the last one");
+    options("stateType", po::value<std::string>()->default_value("mpt"), "mpt or storage");
+    options("parallelThreads", po::value<unsigned>()->default_value(0),
+        "threads executing the transactions in parallel, only used by the storage state");
+    options("profile,p", "profile the transactions and report the costliest contracts");
+    options("help,h", "help of the block replay benchmark");
+
+    po::variables_map vm;
+    try
+    {
+        po::store(po::parse_command_line(argc, argv, replay_options), vm);
+    }
+    catch (...)
+    {
+        std::cout << "invalid input" << std::endl;
+        exit(0);
+    }
+    /// help information
+    if (vm.count("help") || vm.count("h") || !vm.count("data"))
+    {
+        std::cout << replay_options << std::endl;
+        exit(0);
+    }
+    return ReplayParams(vm);
+}
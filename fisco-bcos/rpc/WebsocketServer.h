@@ -119,6 +119,9 @@ class session : public std::enable_shared_from_this<session>
         m_mapRpc.insert(std::make_pair(
             "sendRawTransaction", std::bind(&RpcFace::sendRawTransactionI, m_rpcFace,
                                       std::placeholders::_1, std::placeholders::_2)));
+        m_mapRpc.insert(std::make_pair(
+            "getExecutionProfile", std::bind(&RpcFace::getExecutionProfileI, m_rpcFace,
+                                       std::placeholders::_1, std::placeholders::_2)));
     }
 
 public:
@@ -121,6 +121,9 @@ bytes BlockChainImp::getCode(Address _address)
 h256 BlockChainImp::numberHash(int64_t _i)
 {
     /// LOG(TRACE) << "BlockChainImp::numberHash _i=" << _i;
+    h256 hash;
+    if (m_blockHashes.get(_i, hash))
+        return hash;
     string numberHash = "";
     Table::Ptr tb = getMemoryTableFactory()->openTable(SYS_NUMBER_2_HASH);
     if (tb)
@@ -133,7 +136,11 @@ h256 BlockChainImp::numberHash(int64_t _i)
         }
     }
     /// LOG(TRACE) << "BlockChainImp::numberHash numberHash=" << numberHash;
-    return h256(numberHash);
+    hash = h256(numberHash);
+    // the blocks committed before the start are cached once read
+    if (hash != h256())
+        m_blockHashes.insert(_i, hash);
+    return hash;
 }
 
 std::shared_ptr<Block> BlockChainImp::getBlockByHash(h256 const& _blockHash)
@@ -163,6 +170,9 @@ void BlockChainImp::setGroupMark(std::string const& groupMark)
         block = std::make_shared<Block>();
         block->setEmptyBlock();
         block->header().appendExtraDataArray(asBytes(groupMark));
+        /// the chains created without a version keep the genesis block of a single extra data
+        if (m_chainVersion > 0)
+            block->header().appendExtraDataArray(asBytes(lexical_cast<string>(m_chainVersion)));
         shared_ptr<MemoryTableFactory> mtb = getMemoryTableFactory();
         Table::Ptr tb = mtb->openTable(SYS_NUMBER_2_HASH);
         if (tb)
@@ -201,23 +211,23 @@ void BlockChainImp::setGroupMark(std::string const& groupMark)
     }
 }
 
-std::shared_ptr<Block> BlockChainImp::getBlockByNumber(int64_t _i)
+unsigned BlockChainImp::chainVersion()
 {
-    /// LOG(TRACE) << "BlockChainImp::getBlockByNumber _i=" << _i;
-    string numberHash = "";
-    string strblock = "";
-    Table::Ptr tb = getMemoryTableFactory()->openTable(SYS_NUMBER_2_HASH);
-    if (tb)
+    std::shared_ptr<Block> block = getBlockByNumber(0);
+    if (block && block->header().extraData().size() > 1)
     {
-        auto entries = tb->select(lexical_cast<std::string>(_i), tb->newCondition());
-        if (entries->size() > 0)
-        {
-            auto entry = entries->get(0);
-            numberHash = entry->getField(SYS_VALUE);
-            return getBlockByHash(h256(numberHash));
-        }
+        return lexical_cast<unsigned>(asString(block->header().extraData(1)));
     }
-    return nullptr;
+    return 0;
+}
+
+std::shared_ptr<Block> BlockChainImp::getBlockByNumber(int64_t _i)
+{
+    /// LOG(TRACE) << "BlockChainImp::getBlockByNumber _i=" << _i;
+    h256 hash = numberHash(_i);
+    if (hash == h256())
+        return nullptr;
+    return getBlockByHash(hash);
 }
 
 Transaction BlockChainImp::getTxByHash(dev::h256 const& _txHash)
@@ -413,6 +423,21 @@ void BlockChainImp::writeBlockInfo(Block& block, std::shared_ptr<ExecutiveContex
     writeHash2Block(block, context);
 }
 
+std::shared_ptr<const BlockHeader> BlockChainImp::headHeader()
+{
+    {
+        ReadGuard l(x_headHeader);
+        if (m_headHeader)
+            return m_headHeader;
+    }
+    auto header = BlockChainInterface::headHeader();
+    WriteGuard l(x_headHeader);
+    // a block committed meanwhile is newer than the loaded one
+    if (!m_headHeader)
+        m_headHeader = header;
+    return m_headHeader;
+}
+
 CommitResult BlockChainImp::commitBlock(Block& block, std::shared_ptr<ExecutiveContext> context)
 {
     int64_t num = number();
@@ -437,6 +462,11 @@ CommitResult BlockChainImp::commitBlock(Block& block, std::shared_ptr<ExecutiveC
         writeTxToBlock(block, context);
         writeBlockInfo(block, context);
         context->dbCommit(block);
+        {
+            WriteGuard l(x_headHeader);
+            m_headHeader = std::make_shared<const BlockHeader>(block.blockHeader());
+        }
+        m_blockHashes.insert(block.blockHeader().number(), block.blockHeader().hash());
         commitMutex.unlock();
         m_onReady();
         return CommitResult::OK;
@@ -23,6 +23,8 @@
 #pragma once
 
 #include "BlockChainInterface.h"
+#include "BlockHashRing.h"
+#include <libdevcore/Guards.h>
 #include <libethcore/Block.h>
 #include <libethcore/Common.h>
 #include <libethcore/Transaction.h>
@@ -52,6 +54,7 @@ public:
     BlockChainImp() {}
     virtual ~BlockChainImp(){};
     int64_t number() override;
+    /// the hashes of the last blocks are kept in memory
     dev::h256 numberHash(int64_t _i) override;
     dev::eth::Transaction getTxByHash(dev::h256 const& _txHash) override;
     dev::eth::LocalisedTransaction getLocalisedTxByHash(dev::h256 const& _txHash) override;
@@ -60,12 +63,18 @@ public:
         dev::h256 const& _txHash) override;
     std::shared_ptr<dev::eth::Block> getBlockByHash(dev::h256 const& _blockHash) override;
     std::shared_ptr<dev::eth::Block> getBlockByNumber(int64_t _i) override;
+    /// cached from the committed blocks, so it's cheap to get the header for each call
+    std::shared_ptr<const dev::eth::BlockHeader> headHeader() override;
     CommitResult commitBlock(dev::eth::Block& block,
         std::shared_ptr<dev::blockverifier::ExecutiveContext> context) override;
     virtual void setStateStorage(dev::storage::Storage::Ptr stateStorage);
     virtual void setStateFactory(dev::executive::StateFactoryInterface::Ptr _stateFactory);
     virtual std::shared_ptr<dev::storage::MemoryTableFactory> getMemoryTableFactory();
     void setGroupMark(std::string const& groupMark) override;
+    /// the version written into the genesis block created by setGroupMark
+    void setChainVersion(unsigned _chainVersion) { m_chainVersion = _chainVersion; }
+    /// @returns the version kept by the genesis block, 0 for the chains created without one
+    unsigned chainVersion();
     virtual std::pair<int64_t, int64_t> totalTransactionCount() override;
     dev::bytes getCode(dev::Address _address) override;
 
@@ -84,9 +93,13 @@ private:
         dev::eth::Block& block, std::shared_ptr<dev::blockverifier::ExecutiveContext> context);
     dev::storage::Storage::Ptr m_stateStorage;
     std::mutex commitMutex;
+    std::shared_ptr<const dev::eth::BlockHeader> m_headHeader;
+    SharedMutex x_headHeader;
+    BlockHashRing m_blockHashes;
     const std::string c_genesisHash =
         "0xeb8b84af3f35165d52cb41abe1a9a3d684703aca4966ce720ecd940bd885517c";
     std::shared_ptr<dev::executive::StateFactoryInterface> m_stateFactory;
+    unsigned m_chainVersion = 0;
 };
 }  // namespace blockchain
 }  // namespace dev
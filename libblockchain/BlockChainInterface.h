@@ -56,6 +56,14 @@ public:
         dev::h256 const& _txHash) = 0;
     virtual std::shared_ptr<dev::eth::Block> getBlockByHash(dev::h256 const& _blockHash) = 0;
     virtual std::shared_ptr<dev::eth::Block> getBlockByNumber(int64_t _i) = 0;
+    /// @returns the header of the highest block, which isn't modified afterwards
+    virtual std::shared_ptr<const dev::eth::BlockHeader> headHeader()
+    {
+        auto block = getBlockByNumber(number());
+        if (!block)
+            return nullptr;
+        return std::make_shared<const dev::eth::BlockHeader>(block->blockHeader());
+    }
     virtual CommitResult commitBlock(
         dev::eth::Block& block, std::shared_ptr<dev::blockverifier::ExecutiveContext>) = 0;
     virtual std::pair<int64_t, int64_t> totalTransactionCount() = 0;
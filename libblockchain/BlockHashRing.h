@@ -0,0 +1,80 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+
+/**
+ * @brief : hashes of the last blocks
+ */
+#pragma once
+
+#include <libdevcore/FixedHash.h>
+#include <libdevcore/Guards.h>
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace dev
+{
+namespace blockchain
+{
+/**
+ * @brief The hashes of the last blocks in a ring indexed by the block number, so that the
+ * hashes asked for by BLOCKHASH, which only reaches the last 256 blocks, and by the parent hash
+ * checks aren't read from the storage. The slot of a block is reused by the block capacity
+ * numbers later.
+ */
+class BlockHashRing
+{
+public:
+    explicit BlockHashRing(size_t _capacity = c_defaultCapacity)
+      : m_ring(std::max<size_t>(_capacity, 1), std::make_pair(int64_t(-1), h256()))
+    {}
+
+    /// @returns false if the block isn't in the ring
+    bool get(int64_t _number, h256& o_hash) const
+    {
+        if (_number < 0)
+            return false;
+        ReadGuard l(x_ring);
+        auto const& slot = m_ring[_number % m_ring.size()];
+        if (slot.first != _number)
+            return false;
+        o_hash = slot.second;
+        return true;
+    }
+
+    /// blocks older than the capacity below the latest inserted block are ignored
+    void insert(int64_t _number, h256 const& _hash)
+    {
+        if (_number < 0)
+            return;
+        WriteGuard l(x_ring);
+        if (_number + int64_t(m_ring.size()) <= m_latest)
+            return;
+        m_ring[_number % m_ring.size()] = std::make_pair(_number, _hash);
+        m_latest = std::max(m_latest, _number);
+    }
+
+private:
+    /// more than the 256 blocks reached by BLOCKHASH
+    static const size_t c_defaultCapacity = 512;
+    mutable SharedMutex x_ring;
+    std::vector<std::pair<int64_t, h256>> m_ring;
+    int64_t m_latest = -1;
+};
+
+}  // namespace blockchain
+}  // namespace dev
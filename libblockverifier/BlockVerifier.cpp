@@ -20,86 +20,526 @@
  */
 #include "BlockVerifier.h"
 #include "ExecutiveContext.h"
+#include "TxDAG.h"
 #include <libethcore/Exceptions.h>
 #include <libethcore/PrecompiledContract.h>
 #include <libethcore/TransactionReceipt.h>
 #include <libexecutive/ExecutionResult.h>
 #include <libexecutive/Executive.h>
+#include <libstorage/Common.h>
+#include <condition_variable>
 #include <exception>
+#include <future>
 using namespace dev;
 using namespace std;
 using namespace dev::eth;
 using namespace dev::blockverifier;
 using namespace dev::executive;
+using namespace dev::storage;
+
+namespace
+{
+bool hasConflict(
+    MemoryTableFactory::AccessSet const& _reads, MemoryTableFactory::AccessSet const& _writes)
+{
+    for (auto const& key : _reads)
+    {
+        if (_writes.count(key))
+            return true;
+    }
+    return false;
+}
+
+/// @returns true if all keys of _access are in the declared tables or keys
+bool coversAccess(ConflictKeys const& _conflictKeys, MemoryTableFactory::AccessSet const& _access)
+{
+    set<string> tables;
+    set<ConflictKey> keys;
+    for (auto const& key : _conflictKeys)
+    {
+        tables.insert(key.first);
+        keys.insert(key);
+    }
+    for (auto const& key : _access)
+    {
+        // opening or creating a declared table accesses its row in _sys_tables_
+        bool declared = keys.count(make_pair(key.first, string())) || keys.count(key) ||
+                        (key.first == SYS_TABLES && tables.count(key.second));
+        if (!declared)
+            return false;
+    }
+    return true;
+}
+
+ConflictKey accountKey(Address const& _address)
+{
+    return make_pair("_contract_data_" + _address.hex() + "_", string());
+}
+}  // namespace
 
 ExecutiveContext::Ptr BlockVerifier::executeBlock(Block& block, BlockInfo const& parentBlockInfo)
+{
+    return executeBlock(block, parentBlockInfo, nullptr);
+}
+
+ChainedStorage::Ptr BlockVerifier::snapshotState(
+    ExecutiveContext::Ptr executiveContext, BlockInfo const& blockInfo)
+{
+    if (!m_chainedExecution)
+        return nullptr;
+    return make_shared<ChainedStorage>(
+        executiveContext->getMemoryTableFactory(), blockInfo.hash, blockInfo.number);
+}
+
+ExecutiveContext::Ptr BlockVerifier::executeChainedBlock(
+    Block& block, BlockInfo const& parentBlockInfo, ChainedStorage::Ptr parentState)
+{
+    if (!m_chainedExecution)
+        return nullptr;
+    return executeBlock(block, parentBlockInfo, parentState);
+}
+
+ExecutiveContext::Ptr BlockVerifier::executeBlock(
+    Block& block, BlockInfo const& parentBlockInfo, Storage::Ptr _parentState)
 {
     LOG(TRACE) << "BlockVerifier::executeBlock tx_num=" << block.transactions().size()
                << " num: " << block.blockHeader().number()
                << " parent hash: " << parentBlockInfo.hash
                << " parent num: " << parentBlockInfo.number
-               << " parent stateRoot: " << parentBlockInfo.stateRoot;
+               << " parent stateRoot: " << parentBlockInfo.stateRoot
+               << " parent committed: " << !_parentState;
+
+    Timer timer;
+    uint64_t hashUs = 0;
+    // per transaction state roots can't be calculated out of order
+    bool parallel = m_threadPool && !m_intermediateStateRoot && block.transactions().size() > 1;
+    BlockHeader tmpHeader = block.blockHeader();
+    ExecutiveContext::Ptr executiveContext =
+        executeTransactions(block, parentBlockInfo, parallel, _parentState, hashUs);
+    if (tmpHeader.receiptsRoot() != h256() && tmpHeader.stateRoot() != h256())
+    {
+        if (parallel && tmpHeader != block.blockHeader())
+        {
+            LOG(WARNING) << "BlockVerifier::executeBlock parallel execution mismatched, "
+                            "re-execute sequentially, num: "
+                         << tmpHeader.number();
+            block.setBlockHeader(tmpHeader);
+            executiveContext =
+                executeTransactions(block, parentBlockInfo, false, _parentState, hashUs);
+        }
+        if (tmpHeader != block.blockHeader())
+        {
+            BOOST_THROW_EXCEPTION(InvalidBlockWithBadStateOrReceipt() << errinfo_comment(
+                                      "Invalid Block with bad stateRoot or ReciptRoot"));
+        }
+    }
+    if (m_profiler)
+    {
+        m_profiler->finishBlock(block.blockHeader().number(), block.transactions().size(),
+            std::chrono::duration_cast<std::chrono::microseconds>(timer.duration()).count(),
+            hashUs);
+    }
+    return executiveContext;
+}
 
-    ExecutiveContext::Ptr executiveContext = std::make_shared<ExecutiveContext>();
+ExecutiveContext::Ptr BlockVerifier::executeTransactions(Block& block,
+    BlockInfo const& parentBlockInfo, bool _parallel, Storage::Ptr _parentState, uint64_t& o_hashUs)
+{
+    ExecutiveContext::Ptr executiveContext;
     try
     {
-        m_executiveContextFactory->initExecutiveContext(
-            parentBlockInfo, parentBlockInfo.stateRoot, executiveContext);
+        executiveContext = m_executiveContextFactory->createExecutiveContext(
+            parentBlockInfo, parentBlockInfo.stateRoot);
     }
     catch (exception& e)
     {
         LOG(ERROR) << "Error:" << e.what();
+        executiveContext = std::make_shared<ExecutiveContext>();
     }
-    unsigned i = 0;
-    BlockHeader tmpHeader = block.blockHeader();
+    if (_parentState)
+        executiveContext->getMemoryTableFactory()->setStateStorage(_parentState);
     block.clearAllReceipts();
-    for (Transaction const& tr : block.transactions())
+    if (_parallel)
     {
-        EnvInfo envInfo(block.blockHeader(), m_pNumberHash,
-            block.getTransactionReceipts().size() > 0 ?
-                block.getTransactionReceipts().back().gasUsed() :
-                0);
-        envInfo.setPrecompiledEngine(executiveContext);
-        std::pair<ExecutionResult, TransactionReceipt> resultReceipt =
-            execute(envInfo, tr, OnOpFunc(), executiveContext);
-        block.appendTransactionReceipt(resultReceipt.second);
-        executiveContext->getState()->commit();
+        // blocks of transactions declaring their conflict keys are scheduled by a DAG without
+        // re-execution, others are executed optimistically
+        vector<ConflictKeys> conflictKeys;
+        for (Transaction const& tr : block.transactions())
+        {
+            conflictKeys.push_back(this->conflictKeys(tr, executiveContext));
+            if (conflictKeys.back().empty())
+                break;
+        }
+        executiveContext->getState()->clear();
+        if (conflictKeys.back().empty())
+        {
+            executeParallel(block, parentBlockInfo, executiveContext);
+        }
+        else if (!executeDAG(block, parentBlockInfo, executiveContext, conflictKeys))
+        {
+            LOG(WARNING) << "BlockVerifier::executeTransactions DAG execution failed, "
+                            "re-execute sequentially, num: "
+                         << block.blockHeader().number();
+            return executeTransactions(block, parentBlockInfo, false, _parentState, o_hashUs);
+        }
     }
+    else
+    {
+        auto blockNumberHash = numberHash(_parentState);
+        for (Transaction const& tr : block.transactions())
+        {
+            EnvInfo envInfo(block.blockHeader(), blockNumberHash,
+                block.getTransactionReceipts().size() > 0 ?
+                    block.getTransactionReceipts().back().gasUsed() :
+                    0);
+            envInfo.setPrecompiledEngine(executiveContext);
+            std::pair<ExecutionResult, TransactionReceipt> resultReceipt =
+                execute(envInfo, tr, OnOpFunc(), executiveContext);
+            block.appendTransactionReceipt(resultReceipt.second);
+            executiveContext->getState()->commit();
+        }
+    }
+    Timer timer;
     block.calReceiptRoot();
     block.header().setStateRoot(executiveContext->getState()->rootHash());
-    if (tmpHeader.receiptsRoot() != h256() && tmpHeader.stateRoot() != h256())
+    o_hashUs += std::chrono::duration_cast<std::chrono::microseconds>(timer.duration()).count();
+    return executiveContext;
+}
+
+void BlockVerifier::executeParallel(
+    Block& block, BlockInfo const& parentBlockInfo, ExecutiveContext::Ptr executiveContext)
+{
+    auto const& transactions = block.transactions();
+    size_t txNum = transactions.size();
+    std::vector<ExecutiveContext::Ptr> contexts(txNum);
+    std::vector<TransactionReceipt> receipts(txNum);
+    auto memoryTableFactory = executiveContext->getMemoryTableFactory();
+    auto stateStorage = memoryTableFactory->stateStorage();
+    auto blockNumberHash = numberHash(stateStorage);
+
+    runOnThreadPool(txNum, [&](size_t i) {
+        contexts[i] = speculate(block.blockHeader(), parentBlockInfo, stateStorage,
+            blockNumberHash, transactions[i], receipts[i]);
+    });
+
+    MemoryTableFactory::AccessSet committedWrites;
+    size_t reexecuted = 0;
+    u256 gasUsed = 0;
+    memoryTableFactory->setTrackAccess(true);
+    for (size_t i = 0; i < txNum; ++i)
     {
-        if (tmpHeader != block.blockHeader())
+        memoryTableFactory->clearAccessSet();
+        if (contexts[i] &&
+            !hasConflict(contexts[i]->getMemoryTableFactory()->readSet(), committedWrites))
         {
-            BOOST_THROW_EXCEPTION(InvalidBlockWithBadStateOrReceipt() << errinfo_comment(
-                                      "Invalid Block with bad stateRoot or ReciptRoot"));
+            memoryTableFactory->applyWrites(*contexts[i]->getMemoryTableFactory());
+            // the state may cache values overwritten by the applied entries
+            executiveContext->getState()->clear();
+            TransactionReceipt const& receipt = receipts[i];
+            block.appendTransactionReceipt(TransactionReceipt(h256(),
+                gasUsed + receipt.gasUsed(), receipt.log(), receipt.status(),
+                receipt.outputBytes(), receipt.contractAddress()));
         }
+        else
+        {
+            EnvInfo envInfo(block.blockHeader(), blockNumberHash, gasUsed);
+            envInfo.setPrecompiledEngine(executiveContext);
+            block.appendTransactionReceipt(
+                execute(envInfo, transactions[i], OnOpFunc(), executiveContext).second);
+            executiveContext->getState()->commit();
+            ++reexecuted;
+        }
+        gasUsed = block.getTransactionReceipts().back().gasUsed();
+        auto const& writes = memoryTableFactory->writeSet();
+        committedWrites.insert(writes.begin(), writes.end());
+        contexts[i].reset();
     }
-    return executiveContext;
+    memoryTableFactory->setTrackAccess(false);
+    memoryTableFactory->clearAccessSet();
+    LOG(DEBUG) << "BlockVerifier::executeParallel num: " << block.blockHeader().number()
+               << " tx_num: " << txNum << " reexecuted: " << reexecuted;
+}
+
+bool BlockVerifier::executeDAG(Block& block, BlockInfo const& parentBlockInfo,
+    ExecutiveContext::Ptr executiveContext, vector<ConflictKeys> const& _conflictKeys)
+{
+    auto const& transactions = block.transactions();
+    size_t txNum = transactions.size();
+    std::vector<TransactionReceipt> receipts(txNum);
+    auto overlay = make_shared<OverlayStorage>(executiveContext->getMemoryTableFactory());
+    auto blockNumberHash = numberHash(executiveContext->getMemoryTableFactory()->stateStorage());
+    TxDAG dag(_conflictKeys);
+
+    runOnThreadPool(m_threadNum, [&](size_t) {
+        for (int64_t i = dag.waitReady(); i >= 0; i = dag.waitReady())
+        {
+            if (executeOnOverlay(block.blockHeader(), parentBlockInfo, blockNumberHash,
+                    transactions[i], _conflictKeys[i], overlay, receipts[i]))
+                dag.done(i);
+            else
+                dag.stop();
+        }
+    });
+    if (dag.stopped())
+    {
+        return false;
+    }
+
+    u256 gasUsed = 0;
+    for (auto const& receipt : receipts)
+    {
+        gasUsed += receipt.gasUsed();
+        block.appendTransactionReceipt(TransactionReceipt(h256(), gasUsed, receipt.log(),
+            receipt.status(), receipt.outputBytes(), receipt.contractAddress()));
+    }
+    LOG(DEBUG) << "BlockVerifier::executeDAG num: " << block.blockHeader().number()
+               << " tx_num: " << txNum;
+    return true;
+}
+
+bool BlockVerifier::executeOnOverlay(BlockHeader const& _header,
+    BlockInfo const& _parentBlockInfo, NumberHashCallBackFunction const& _numberHash,
+    Transaction const& _t, ConflictKeys const& _conflictKeys, OverlayStorage::Ptr _overlay,
+    TransactionReceipt& o_receipt)
+{
+    try
+    {
+        ExecutiveContext::Ptr executiveContext = m_executiveContextFactory->createExecutiveContext(
+            _parentBlockInfo, _parentBlockInfo.stateRoot);
+        auto memoryTableFactory = executiveContext->getMemoryTableFactory();
+        memoryTableFactory->setStateStorage(_overlay);
+        memoryTableFactory->setTrackAccess(true);
+        EnvInfo envInfo(_header, _numberHash, 0);
+        envInfo.setPrecompiledEngine(executiveContext);
+        o_receipt = execute(envInfo, _t, OnOpFunc(), executiveContext).second;
+        if (!coversAccess(_conflictKeys, memoryTableFactory->readSet()) ||
+            !coversAccess(_conflictKeys, memoryTableFactory->writeSet()))
+        {
+            LOG(WARNING) << "BlockVerifier::executeOnOverlay undeclared keys accessed, tx: "
+                         << _t.sha3();
+            return false;
+        }
+        _overlay->applyWrites(*memoryTableFactory);
+        return true;
+    }
+    catch (exception& e)
+    {
+        LOG(TRACE) << "BlockVerifier::executeOnOverlay failed: " << e.what();
+    }
+    return false;
+}
+
+ConflictKeys BlockVerifier::conflictKeys(
+    Transaction const& _t, ExecutiveContext::Ptr executiveContext)
+{
+    ConflictKeys keys;
+    try
+    {
+        if (_t.isCreation())
+            return keys;
+        Address const& to = _t.receiveAddress();
+        if (executiveContext->isPrecompiled(to))
+        {
+            // a value would be transferred to the account of the precompiled
+            if (_t.value() == 0 && _t.data().size() >= 4)
+                keys = executiveContext->getPrecompiled(to)->conflictKeys(&_t.data());
+        }
+        else if (_t.data().empty() && !executiveContext->isOrginPrecompiled(to) &&
+                 !executiveContext->getState()->addressHasCode(to))
+        {
+            // transfer
+            keys.push_back(accountKey(to));
+        }
+        // the nonce of the sender is increased
+        if (!keys.empty())
+            keys.push_back(accountKey(_t.sender()));
+    }
+    catch (exception& e)
+    {
+        LOG(TRACE) << "BlockVerifier::conflictKeys failed: " << e.what();
+        keys.clear();
+    }
+    return keys;
+}
+
+void BlockVerifier::runOnThreadPool(size_t _taskNum, function<void(size_t)> const& _task)
+{
+    size_t pending = _taskNum;
+    Mutex x_pending;
+    std::condition_variable pendingDone;
+    for (size_t i = 0; i < _taskNum; ++i)
+    {
+        m_threadPool->enqueue([&, i]() {
+            _task(i);
+            Guard l(x_pending);
+            if (--pending == 0)
+                pendingDone.notify_all();
+        });
+    }
+    UniqueGuard l(x_pending);
+    pendingDone.wait(l, [&]() { return pending == 0; });
+}
+
+ExecutiveContext::Ptr BlockVerifier::speculate(BlockHeader const& _header,
+    BlockInfo const& _parentBlockInfo, Storage::Ptr _stateStorage,
+    NumberHashCallBackFunction const& _numberHash, Transaction const& _t,
+    TransactionReceipt& o_receipt)
+{
+    try
+    {
+        ExecutiveContext::Ptr executiveContext = m_executiveContextFactory->createExecutiveContext(
+            _parentBlockInfo, _parentBlockInfo.stateRoot);
+        executiveContext->getMemoryTableFactory()->setStateStorage(_stateStorage);
+        executiveContext->getMemoryTableFactory()->setTrackAccess(true);
+        // the gas used by the preceding transactions is added when committing the receipt
+        EnvInfo envInfo(_header, _numberHash, 0);
+        envInfo.setPrecompiledEngine(executiveContext);
+        o_receipt = execute(envInfo, _t, OnOpFunc(), executiveContext).second;
+        return executiveContext;
+    }
+    catch (exception& e)
+    {
+        LOG(TRACE) << "BlockVerifier::speculate failed, execute in block order: " << e.what();
+    }
+    return nullptr;
+}
+
+BlockVerifier::NumberHashCallBackFunction BlockVerifier::numberHash(Storage::Ptr _stateStorage)
+{
+    auto chainedStorage = dynamic_pointer_cast<ChainedStorage>(_stateStorage);
+    if (!chainedStorage)
+        return m_pNumberHash;
+    // the uncommitted blocks aren't in the block chain yet
+    auto parentNumberHash = numberHash(chainedStorage->storage());
+    h256 hash = chainedStorage->blockHash();
+    int64_t number = chainedStorage->blockNumber();
+    return [parentNumberHash, hash, number](int64_t x) {
+        return x == number ? hash : parentNumberHash(x);
+    };
 }
 
 std::pair<ExecutionResult, TransactionReceipt> BlockVerifier::executeTransaction(
     const BlockHeader& blockHeader, dev::eth::Transaction const& _t)
 {
-    ExecutiveContext::Ptr executiveContext = std::make_shared<ExecutiveContext>();
+    ExecutiveContext::Ptr executiveContext;
     try
     {
         BlockInfo blockInfo{blockHeader.hash(), blockHeader.number(), blockHeader.stateRoot()};
-        m_executiveContextFactory->initExecutiveContext(
-            blockInfo, blockHeader.stateRoot(), executiveContext);
+        executiveContext =
+            m_executiveContextFactory->createExecutiveContext(blockInfo, blockHeader.stateRoot());
     }
     catch (exception& e)
     {
         LOG(ERROR) << "Error:" << e.what();
+        executiveContext = std::make_shared<ExecutiveContext>();
     }
 
     EnvInfo envInfo(blockHeader, m_pNumberHash, 0);
     envInfo.setPrecompiledEngine(executiveContext);
-    return execute(envInfo, _t, OnOpFunc(), executiveContext);
+    return execute(envInfo, _t, OnOpFunc(), executiveContext, m_intermediateStateRoot);
+}
+
+std::pair<ExecutionResult, TransactionReceipt> BlockVerifier::executeCall(
+    const BlockHeader& blockHeader, Transaction const& _t)
+{
+    typedef std::pair<ExecutionResult, TransactionReceipt> Result;
+    Result result;
+    // the cached results aren't limited by the pending calls
+    auto callCache = m_callCache;
+    if (callCache && callCache->get(blockHeader.hash(), _t, result))
+        return result;
+    if (++m_pendingCalls > m_maxPendingCalls && m_maxPendingCalls > 0)
+    {
+        --m_pendingCalls;
+        LOG(WARNING) << "BlockVerifier::executeCall rejected, max pending calls: "
+                     << m_maxPendingCalls;
+        BOOST_THROW_EXCEPTION(TooManyPendingCalls());
+    }
+    try
+    {
+        if (m_callPool)
+        {
+            // calls don't compete with the block execution for its thread pool
+            auto task = std::make_shared<std::packaged_task<Result()>>(
+                [&]() { return call(blockHeader, _t); });
+            auto future = task->get_future();
+            m_callPool->enqueue([task]() { (*task)(); });
+            result = future.get();
+        }
+        else
+        {
+            result = call(blockHeader, _t);
+        }
+    }
+    catch (...)
+    {
+        --m_pendingCalls;
+        throw;
+    }
+    --m_pendingCalls;
+    if (callCache)
+        callCache->store(blockHeader.hash(), _t, result);
+    return result;
+}
+
+std::pair<ExecutionResult, TransactionReceipt> BlockVerifier::call(
+    const BlockHeader& blockHeader, Transaction const& _t)
+{
+    BlockInfo blockInfo{blockHeader.hash(), blockHeader.number(), blockHeader.stateRoot()};
+    auto executiveContext =
+        m_executiveContextFactory->createExecutiveContext(blockInfo, blockHeader.stateRoot());
+    EnvInfo envInfo(blockHeader, m_pNumberHash, 0);
+    envInfo.setPrecompiledEngine(executiveContext);
+    return execute(envInfo, _t, OnOpFunc(), executiveContext, false);
 }
 
 std::pair<ExecutionResult, TransactionReceipt> BlockVerifier::execute(EnvInfo const& _envInfo,
     Transaction const& _t, OnOpFunc const& _onOp, ExecutiveContext::Ptr executiveContext)
+{
+    if (m_profiler && m_profiler->profileTransactions())
+        return profile(_envInfo, _t, _onOp, executiveContext);
+    return execute(_envInfo, _t, _onOp, executiveContext, m_intermediateStateRoot);
+}
+
+std::pair<ExecutionResult, TransactionReceipt> BlockVerifier::profile(EnvInfo const& _envInfo,
+    Transaction const& _t, OnOpFunc const& _onOp, ExecutiveContext::Ptr executiveContext)
+{
+    TransactionProfile profile;
+    auto memoryTableFactory = executiveContext->getMemoryTableFactory();
+    TableAccessStats accessStats;
+    if (memoryTableFactory)
+        accessStats = memoryTableFactory->accessStats();
+    uint64_t precompiledCalls = executiveContext->precompiledCalls();
+    OnOpFunc onOp = [&profile, &_onOp](uint64_t _steps, uint64_t _pc, Instruction _inst,
+                        bigint _newMemSize, bigint _gasCost, bigint _gas, VMFace const* _vm,
+                        ExtVMFace const* _ext) {
+        ++profile.opcodes[(uint8_t)_inst];
+        if (_onOp)
+            _onOp(_steps, _pc, _inst, _newMemSize, _gasCost, _gas, _vm, _ext);
+    };
+
+    Timer timer;
+    auto result = execute(_envInfo, _t, onOp, executiveContext, m_intermediateStateRoot);
+    profile.timeUs =
+        std::chrono::duration_cast<std::chrono::microseconds>(timer.duration()).count();
+    profile.hash = _t.sha3();
+    profile.contract = _t.isCreation() ? result.second.contractAddress() : _t.receiveAddress();
+    profile.gasUsed = result.first.gasUsed;
+    if (memoryTableFactory)
+    {
+        TableAccessStats const& stats = memoryTableFactory->accessStats();
+        profile.selects = stats.selects - accessStats.selects;
+        profile.loads = stats.loads - accessStats.loads;
+        profile.writes = stats.writes - accessStats.writes;
+    }
+    profile.precompiledCalls = executiveContext->precompiledCalls() - precompiledCalls;
+    m_profiler->addTransaction(_envInfo.number(), profile);
+    return result;
+}
+
+std::pair<ExecutionResult, TransactionReceipt> BlockVerifier::execute(EnvInfo const& _envInfo,
+    Transaction const& _t, OnOpFunc const& _onOp, ExecutiveContext::Ptr executiveContext,
+    bool _stateRoot)
 {
     LOG(TRACE) << "BlockVerifier::execute ";
 
@@ -123,7 +563,10 @@ std::pair<ExecutionResult, TransactionReceipt> BlockVerifier::execute(EnvInfo co
         e.go(onOp);
     e.finalize();
 
-    return make_pair(res,
-        TransactionReceipt(executiveContext->getState()->rootHash(), startGasUsed + e.gasUsed(),
-            e.logs(), e.status(), e.takeOutput().takeBytes(), e.newAddress()));
+    // the older chains number the registered precompileds through the whole block
+    if (executiveContext->chainVersion() > 0)
+        executiveContext->clearRegisteredPrecompiled();
+    h256 stateRoot = _stateRoot ? executiveContext->getState()->rootHash() : h256();
+    return make_pair(res, TransactionReceipt(stateRoot, startGasUsed + e.gasUsed(), e.logs(),
+                              e.status(), e.takeOutput().takeBytes(), e.newAddress()));
 }
@@ -21,10 +21,13 @@
 #pragma once
 
 #include "BlockVerifierInterface.h"
+#include "CallCache.h"
+#include "ExecutionProfiler.h"
 #include "ExecutiveContext.h"
 #include "ExecutiveContextFactory.h"
 #include "Precompiled.h"
 #include <libdevcore/FixedHash.h>
+#include <libdevcore/ThreadPool.h>
 #include <libdevcore/easylog.h>
 #include <libdevcrypto/Common.h>
 #include <libethcore/Block.h>
@@ -33,7 +36,9 @@
 #include <libevm/ExtVMFace.h>
 #include <libexecutive/ExecutionResult.h>
 #include <libmptstate/State.h>
+#include <libstorage/OverlayStorage.h>
 #include <boost/function.hpp>
+#include <atomic>
 #include <memory>
 namespace dev
 {
@@ -64,8 +69,16 @@ public:
 
     ExecutiveContext::Ptr executeBlock(dev::eth::Block& block, BlockInfo const& parentBlockInfo);
 
+    dev::storage::ChainedStorage::Ptr snapshotState(
+        ExecutiveContext::Ptr executiveContext, BlockInfo const& blockInfo);
+    ExecutiveContext::Ptr executeChainedBlock(dev::eth::Block& block,
+        BlockInfo const& parentBlockInfo, dev::storage::ChainedStorage::Ptr parentState);
+
     std::pair<dev::executive::ExecutionResult, dev::eth::TransactionReceipt> executeTransaction(
         const dev::eth::BlockHeader& blockHeader, dev::eth::Transaction const& _t);
+    /// @throws TooManyPendingCalls if the maximum number of pending calls is reached
+    std::pair<dev::executive::ExecutionResult, dev::eth::TransactionReceipt> executeCall(
+        const dev::eth::BlockHeader& blockHeader, dev::eth::Transaction const& _t);
 
     std::pair<dev::executive::ExecutionResult, dev::eth::TransactionReceipt> execute(
         dev::eth::EnvInfo const& _envInfo, dev::eth::Transaction const& _t,
@@ -82,10 +95,97 @@ public:
     {
         m_pNumberHash = _pNumberHash;
     }
+    /// calculating the state root hashes all dirty tables, when disabled receipts carry a zero
+    /// state root and the state root is only calculated once per block
+    void setIntermediateStateRoot(bool _intermediateStateRoot)
+    {
+        m_intermediateStateRoot = _intermediateStateRoot;
+    }
+    /// execute the transactions of a block speculatively on _threadNum threads, 0 executes them
+    /// one by one. Requires a table based state and no intermediate state roots
+    void setParallelExecution(size_t _threadNum)
+    {
+        m_threadNum = _threadNum;
+        m_threadPool = _threadNum > 0 ?
+                           std::make_shared<dev::ThreadPool>("BlockVerifier", _threadNum) :
+                           nullptr;
+    }
+    /// allow executing blocks on the snapshot of their uncommitted parent block, requires a
+    /// table based state
+    void setChainedExecution(bool _chainedExecution) { m_chainedExecution = _chainedExecution; }
+    /// execute the calls on _threadNum threads of their own, 0 executes them on the calling
+    /// thread. The calls beyond _maxPendingCalls waiting or executing are rejected, 0 for no limit
+    void setCallExecution(size_t _threadNum, size_t _maxPendingCalls)
+    {
+        m_callPool =
+            _threadNum > 0 ? std::make_shared<dev::ThreadPool>("Call", _threadNum) : nullptr;
+        m_maxPendingCalls = _maxPendingCalls;
+    }
+    /// cache the call results, nullptr to disable
+    void setCallCache(CallCache::Ptr _callCache) { m_callCache = _callCache; }
+    /// profile the transactions of the executed blocks, nullptr to disable
+    void setProfiler(ExecutionProfiler::Ptr _profiler) { m_profiler = _profiler; }
+    ExecutionProfiler::Ptr profiler() override { return m_profiler; }
 
 private:
+    /// _stateRoot: fill the receipt with the state root after the transaction
+    std::pair<dev::executive::ExecutionResult, dev::eth::TransactionReceipt> execute(
+        dev::eth::EnvInfo const& _envInfo, dev::eth::Transaction const& _t,
+        dev::eth::OnOpFunc const& _onOp, dev::blockverifier::ExecutiveContext::Ptr executiveContext,
+        bool _stateRoot);
+    /// execute _t and add its profile to m_profiler
+    std::pair<dev::executive::ExecutionResult, dev::eth::TransactionReceipt> profile(
+        dev::eth::EnvInfo const& _envInfo, dev::eth::Transaction const& _t,
+        dev::eth::OnOpFunc const& _onOp, ExecutiveContext::Ptr executiveContext);
+    /// execute a call on a pooled context, its state root isn't calculated and its context is
+    /// never committed
+    std::pair<dev::executive::ExecutionResult, dev::eth::TransactionReceipt> call(
+        const dev::eth::BlockHeader& blockHeader, dev::eth::Transaction const& _t);
+    /// _parentState is the state storage of the parent block, nullptr if it is committed
+    ExecutiveContext::Ptr executeBlock(dev::eth::Block& block, BlockInfo const& parentBlockInfo,
+        dev::storage::Storage::Ptr _parentState);
+    /// adds the time calculating the receipt and state roots to o_hashUs
+    ExecutiveContext::Ptr executeTransactions(dev::eth::Block& block,
+        BlockInfo const& parentBlockInfo, bool _parallel, dev::storage::Storage::Ptr _parentState,
+        uint64_t& o_hashUs);
+    /// execute all transactions concurrently on the state of the parent block, then commit them
+    /// in block order, re-executing the ones which read a key written by a preceding transaction
+    void executeParallel(dev::eth::Block& block, BlockInfo const& parentBlockInfo,
+        ExecutiveContext::Ptr executiveContext);
+    /// execute the transactions by the dependencies of their conflict keys, each on the writes of
+    /// the transactions it depends on
+    /// @returns false if a transaction failed or accessed undeclared keys
+    bool executeDAG(dev::eth::Block& block, BlockInfo const& parentBlockInfo,
+        ExecutiveContext::Ptr executiveContext, std::vector<ConflictKeys> const& _conflictKeys);
+    bool executeOnOverlay(dev::eth::BlockHeader const& _header, BlockInfo const& _parentBlockInfo,
+        NumberHashCallBackFunction const& _numberHash, dev::eth::Transaction const& _t,
+        ConflictKeys const& _conflictKeys, dev::storage::OverlayStorage::Ptr _overlay,
+        dev::eth::TransactionReceipt& o_receipt);
+    /// @returns the keys accessed by _t, empty if they can't be known before execution
+    ConflictKeys conflictKeys(
+        dev::eth::Transaction const& _t, ExecutiveContext::Ptr executiveContext);
+    /// run _task(0) to _task(_taskNum - 1) on the thread pool and wait for all of them
+    void runOnThreadPool(size_t _taskNum, std::function<void(size_t)> const& _task);
+    /// @returns the context holding the writes of _t, or nullptr if _t must be re-executed
+    ExecutiveContext::Ptr speculate(dev::eth::BlockHeader const& _header,
+        BlockInfo const& _parentBlockInfo, dev::storage::Storage::Ptr _stateStorage,
+        NumberHashCallBackFunction const& _numberHash, dev::eth::Transaction const& _t,
+        dev::eth::TransactionReceipt& o_receipt);
+    /// @returns the block hashes seen by the transactions executed on _stateStorage, including
+    /// the hashes of its uncommitted blocks
+    NumberHashCallBackFunction numberHash(dev::storage::Storage::Ptr _stateStorage);
+
     ExecutiveContextFactory::Ptr m_executiveContextFactory;
     NumberHashCallBackFunction m_pNumberHash;
+    bool m_intermediateStateRoot = true;
+    bool m_chainedExecution = false;
+    size_t m_threadNum = 0;
+    dev::ThreadPool::Ptr m_threadPool;
+    dev::ThreadPool::Ptr m_callPool;
+    size_t m_maxPendingCalls = 0;
+    std::atomic<size_t> m_pendingCalls = {0};
+    CallCache::Ptr m_callCache;
+    ExecutionProfiler::Ptr m_profiler;
 };
 
 }  // namespace blockverifier
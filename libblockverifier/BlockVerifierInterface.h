@@ -21,6 +21,7 @@
 #pragma once
 
 #include "Common.h"
+#include "ExecutionProfiler.h"
 #include "ExecutiveContext.h"
 #include "Precompiled.h"
 #include <libdevcore/FixedHash.h>
@@ -32,6 +33,7 @@
 #include <libevm/ExtVMFace.h>
 #include <libexecutive/ExecutionResult.h>
 #include <libmptstate/State.h>
+#include <libstorage/ChainedStorage.h>
 #include <memory>
 
 namespace dev
@@ -55,6 +57,31 @@ public:
     virtual std::pair<dev::executive::ExecutionResult, dev::eth::TransactionReceipt>
     executeTransaction(
         const dev::eth::BlockHeader& blockHeader, dev::eth::Transaction const& _t) = 0;
+    /// execute a call on the state of blockHeader without changing it, may be called
+    /// concurrently with the other calls and the block execution
+    virtual std::pair<dev::executive::ExecutionResult, dev::eth::TransactionReceipt> executeCall(
+        const dev::eth::BlockHeader& blockHeader, dev::eth::Transaction const& _t)
+    {
+        return executeTransaction(blockHeader, _t);
+    }
+
+    /// snapshot the state of the executed block _blockInfo, so that its child can be executed by
+    /// executeChainedBlock while the block is committed. If the block fails to commit, abort the
+    /// snapshot to drop the contexts executed on it
+    /// @returns nullptr if the state can't be chained
+    virtual dev::storage::ChainedStorage::Ptr snapshotState(
+        ExecutiveContext::Ptr, BlockInfo const&)
+    {
+        return nullptr;
+    }
+    /// execute the block on the snapshot of its parent block
+    virtual ExecutiveContext::Ptr executeChainedBlock(
+        dev::eth::Block&, BlockInfo const&, dev::storage::ChainedStorage::Ptr)
+    {
+        return nullptr;
+    }
+    /// @returns the profiler of the executed blocks, nullptr if profiling is disabled
+    virtual ExecutionProfiler::Ptr profiler() { return nullptr; }
 };
 
 }  // namespace blockverifier
@@ -0,0 +1,146 @@
+/*
+    This file is part of FISCO-BCOS.
+
+    FISCO-BCOS is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FISCO-BCOS is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file CallCache.h
+ *  @record cache of the results of the calls executed on the head block
+ */
+
+#pragma once
+
+#include <libdevcore/FixedHash.h>
+#include <libdevcore/Guards.h>
+#include <libdevcore/RLP.h>
+#include <libdevcore/SHA3.h>
+#include <libethcore/Transaction.h>
+#include <libethcore/TransactionReceipt.h>
+#include <libexecutive/ExecutionResult.h>
+#include <atomic>
+#include <list>
+#include <memory>
+#include <unordered_map>
+
+namespace dev
+{
+namespace blockverifier
+{
+/**
+ * @brief Thread-safe LRU cache of the call results, keyed by the block the call is executed on
+ * and the sender, receiver, value, gas and data of the call. A call executed on the same block
+ * always has the same result, the cache is cleared when a block is committed to free the
+ * results no call will hit anymore. The least recently used results are evicted once their
+ * estimated size exceeds the limit.
+ */
+class CallCache
+{
+public:
+    typedef std::shared_ptr<CallCache> Ptr;
+    typedef std::pair<dev::executive::ExecutionResult, dev::eth::TransactionReceipt> Result;
+
+    explicit CallCache(size_t _maxBytes) : m_maxBytes(_maxBytes) {}
+
+    /// @returns false if the result isn't cached
+    bool get(h256 const& _blockHash, dev::eth::Transaction const& _t, Result& o_result)
+    {
+        h256 key = callKey(_blockHash, _t);
+        Guard l(x_cache);
+        auto it = m_cache.find(key);
+        if (it == m_cache.end())
+        {
+            ++m_misses;
+            return false;
+        }
+        ++m_hits;
+        m_lru.splice(m_lru.begin(), m_lru, it->second);
+        o_result = it->second->result;
+        return true;
+    }
+
+    void store(h256 const& _blockHash, dev::eth::Transaction const& _t, Result const& _result)
+    {
+        h256 key = callKey(_blockHash, _t);
+        size_t size = resultSize(_result);
+        if (size > m_maxBytes)
+            return;
+        Guard l(x_cache);
+        if (m_cache.count(key))
+            return;
+        m_lru.push_front(Item{key, _result, size});
+        m_cache[key] = m_lru.begin();
+        m_bytes += size;
+        while (m_bytes > m_maxBytes)
+        {
+            m_bytes -= m_lru.back().size;
+            m_cache.erase(m_lru.back().key);
+            m_lru.pop_back();
+        }
+    }
+
+    void clear()
+    {
+        Guard l(x_cache);
+        m_lru.clear();
+        m_cache.clear();
+        m_bytes = 0;
+    }
+
+    uint64_t hits() const { return m_hits; }
+    uint64_t misses() const { return m_misses; }
+    size_t bytes()
+    {
+        Guard l(x_cache);
+        return m_bytes;
+    }
+
+private:
+    struct Item
+    {
+        h256 key;
+        Result result;
+        size_t size;
+    };
+    typedef std::list<Item> LRUList;
+
+    static h256 callKey(h256 const& _blockHash, dev::eth::Transaction const& _t)
+    {
+        RLPStream s(6);
+        s << _blockHash << _t.receiveAddress() << _t.safeSender() << _t.value() << _t.gas()
+          << _t.data();
+        return sha3(s.out());
+    }
+
+    /// estimated memory used by the cached result
+    static size_t resultSize(Result const& _result)
+    {
+        size_t size = sizeof(Item) + c_entryOverhead + _result.first.output.size() +
+                      _result.second.outputBytes().size();
+        for (auto const& log : _result.second.log())
+            size += sizeof(log) + log.data.size() + log.topics.size() * sizeof(h256);
+        return size;
+    }
+
+    /// the nodes of the map and the list
+    static const size_t c_entryOverhead = 64;
+    Mutex x_cache;
+    LRUList m_lru;
+    std::unordered_map<h256, LRUList::iterator> m_cache;
+    size_t m_maxBytes;
+    size_t m_bytes = 0;
+    std::atomic<uint64_t> m_hits = {0};
+    std::atomic<uint64_t> m_misses = {0};
+};
+
+}  // namespace blockverifier
+}  // namespace dev
@@ -0,0 +1,124 @@
+/*
+    This file is part of FISCO-BCOS.
+
+    FISCO-BCOS is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FISCO-BCOS is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file ExecutionProfiler.cpp
+ *  @record profiles of the transactions executed in the blocks
+ */
+
+#include "ExecutionProfiler.h"
+#include <libdevcore/easylog.h>
+#include <algorithm>
+
+using namespace std;
+using namespace dev;
+using namespace dev::blockverifier;
+
+namespace
+{
+/// the contracts logged every logInterval blocks
+const size_t c_loggedContracts = 10;
+}  // namespace
+
+void TransactionProfile::add(TransactionProfile const& _profile)
+{
+    timeUs += _profile.timeUs;
+    gasUsed += _profile.gasUsed;
+    selects += _profile.selects;
+    loads += _profile.loads;
+    writes += _profile.writes;
+    precompiledCalls += _profile.precompiledCalls;
+    for (size_t i = 0; i < opcodes.size(); ++i)
+        opcodes[i] += _profile.opcodes[i];
+}
+
+void ExecutionProfiler::addTransaction(int64_t _blockNumber, TransactionProfile const& _profile)
+{
+    Guard l(x_profiles);
+    m_pending[_blockNumber].push_back(_profile);
+}
+
+void ExecutionProfiler::finishBlock(
+    int64_t _blockNumber, size_t _transactions, uint64_t _timeUs, uint64_t _hashUs)
+{
+    auto block = make_shared<BlockProfile>();
+    block->number = _blockNumber;
+    block->timeUs = _timeUs;
+    block->hashUs = _hashUs;
+    block->transactions = _transactions;
+    {
+        Guard l(x_profiles);
+        auto it = m_pending.find(_blockNumber);
+        if (it != m_pending.end())
+            block->executions = move(it->second);
+        // the blocks failed to execute, or executed again
+        m_pending.erase(m_pending.begin(), m_pending.upper_bound(_blockNumber));
+    }
+    for (auto const& execution : block->executions)
+    {
+        block->total.add(execution);
+        block->contracts[execution.contract].add(execution);
+    }
+    LOG(DEBUG) << "ExecutionProfiler block: " << _blockNumber << " tx_num: " << _transactions
+               << " executions: " << block->executions.size() << " time_us: " << _timeUs
+               << " hash_us: " << _hashUs << " execute_us: " << block->total.timeUs
+               << " gas: " << block->total.gasUsed << " selects: " << block->total.selects
+               << " loads: " << block->total.loads
+               << " writes: " << block->total.writes
+               << " precompiled_calls: " << block->total.precompiledCalls;
+
+    Guard l(x_profiles);
+    m_blocks.push_back(block);
+    while (m_blocks.size() > m_maxBlocks)
+        m_blocks.pop_front();
+    if (m_logInterval > 0 && ++m_finished % m_logInterval == 0)
+        logContracts();
+}
+
+vector<shared_ptr<const BlockProfile>> ExecutionProfiler::blockProfiles()
+{
+    Guard l(x_profiles);
+    return vector<shared_ptr<const BlockProfile>>(m_blocks.begin(), m_blocks.end());
+}
+
+void ExecutionProfiler::logContracts()
+{
+    map<Address, TransactionProfile> contracts;
+    for (auto const& block : m_blocks)
+    {
+        for (auto const& it : block->contracts)
+            contracts[it.first].add(it.second);
+    }
+    vector<pair<Address, TransactionProfile const*>> sorted;
+    for (auto const& it : contracts)
+        sorted.push_back(make_pair(it.first, &it.second));
+    sort(sorted.begin(), sorted.end(),
+        [](pair<Address, TransactionProfile const*> const& _a,
+            pair<Address, TransactionProfile const*> const& _b) {
+            return _a.second->timeUs > _b.second->timeUs;
+        });
+    if (sorted.size() > c_loggedContracts)
+        sorted.resize(c_loggedContracts);
+    LOG(INFO) << "ExecutionProfiler costliest contracts of the last " << m_blocks.size()
+              << " blocks:";
+    for (auto const& it : sorted)
+    {
+        LOG(INFO) << "ExecutionProfiler contract: " << it.first
+                  << " time_us: " << it.second->timeUs << " gas: " << it.second->gasUsed
+                  << " selects: " << it.second->selects << " loads: " << it.second->loads
+                  << " writes: " << it.second->writes
+                  << " precompiled_calls: " << it.second->precompiledCalls;
+    }
+}
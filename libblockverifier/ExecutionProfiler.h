@@ -0,0 +1,117 @@
+/*
+    This file is part of FISCO-BCOS.
+
+    FISCO-BCOS is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FISCO-BCOS is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file ExecutionProfiler.h
+ *  @record profiles of the transactions executed in the blocks
+ */
+
+#pragma once
+
+#include <libdevcore/Address.h>
+#include <libdevcore/Common.h>
+#include <libdevcore/FixedHash.h>
+#include <libdevcore/Guards.h>
+#include <array>
+#include <deque>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace dev
+{
+namespace blockverifier
+{
+/// the costs of an executed transaction
+struct TransactionProfile
+{
+    h256 hash;
+    /// the called contract, or the created one
+    Address contract;
+    uint64_t timeUs = 0;
+    u256 gasUsed;
+    /// operations on the tables, loads are the keys which weren't cached by their table
+    uint64_t selects = 0;
+    uint64_t loads = 0;
+    uint64_t writes = 0;
+    uint64_t precompiledCalls = 0;
+    /// the number of the executed instructions by opcode
+    std::array<uint64_t, 256> opcodes;
+
+    TransactionProfile() { opcodes.fill(0); }
+    /// add the costs of _profile, keeps the hash and the contract
+    void add(TransactionProfile const& _profile);
+};
+
+/// the costs of the transactions of an executed block
+struct BlockProfile
+{
+    int64_t number = 0;
+    uint64_t timeUs = 0;
+    /// the time calculating the receipt and state roots, included in timeUs
+    uint64_t hashUs = 0;
+    size_t transactions = 0;
+    /// the executions of the transactions, more than the transactions if some are re-executed
+    /// after a speculative execution
+    std::vector<TransactionProfile> executions;
+    /// the costs of all executions
+    TransactionProfile total;
+    /// the costs of the executions by contract
+    std::map<Address, TransactionProfile> contracts;
+};
+
+/**
+ * @brief Collects the profiles of the transactions executed concurrently for the blocks, and
+ * keeps the profiles of the last blocks. The costliest contracts of the last blocks are logged
+ * every logInterval blocks.
+ */
+class ExecutionProfiler
+{
+public:
+    typedef std::shared_ptr<ExecutionProfiler> Ptr;
+
+    /// only the blocks are timed if _profileTransactions is false, which doesn't slow down the
+    /// execution of the transactions
+    ExecutionProfiler(
+        size_t _maxBlocks = 16, size_t _logInterval = 100, bool _profileTransactions = true)
+      : m_maxBlocks(std::max<size_t>(_maxBlocks, 1)),
+        m_logInterval(_logInterval),
+        m_profileTransactions(_profileTransactions)
+    {}
+
+    bool profileTransactions() const { return m_profileTransactions; }
+    void addTransaction(int64_t _blockNumber, TransactionProfile const& _profile);
+    /// aggregate the transactions added for the block _blockNumber, the blocks which aren't
+    /// finished until a later block is finished are dropped
+    void finishBlock(
+        int64_t _blockNumber, size_t _transactions, uint64_t _timeUs, uint64_t _hashUs = 0);
+
+    /// @returns the profiles of the last blocks, the latest last
+    std::vector<std::shared_ptr<const BlockProfile>> blockProfiles();
+
+private:
+    void logContracts();
+
+    Mutex x_profiles;
+    std::map<int64_t, std::vector<TransactionProfile>> m_pending;
+    std::deque<std::shared_ptr<const BlockProfile>> m_blocks;
+    size_t m_maxBlocks;
+    size_t m_logInterval;
+    bool m_profileTransactions;
+    size_t m_finished = 0;
+};
+
+}  // namespace blockverifier
+}  // namespace dev
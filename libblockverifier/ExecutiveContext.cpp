@@ -42,6 +42,7 @@ bytes ExecutiveContext::call(Address address, bytesConstRef param)
 
         if (p)
         {
+            ++m_precompiledCalls;
             bytes out = p->call(shared_from_this(), param);
             return out;
         }
@@ -62,13 +63,35 @@ bytes ExecutiveContext::call(Address address, bytesConstRef param)
 
 Address ExecutiveContext::registerPrecompiled(Precompiled::Ptr p)
 {
-    Address address(++m_addressCount);
+    m_registeredPrecompiled.push_back(p);
+
+    return Address(c_registeredAddressBase + m_registeredPrecompiled.size());
+}
 
-    m_address2Precompiled.insert(std::make_pair(address, p));
 
-    return address;
+void ExecutiveContext::clearRegisteredPrecompiled()
+{
+    m_registeredPrecompiled.clear();
 }
 
+Precompiled::Ptr ExecutiveContext::getRegisteredPrecompiled(Address const& _address) const
+{
+    // the registered addresses fit in their last 4 bytes
+    for (size_t i = 0; i < Address::size - 4; ++i)
+    {
+        if (_address[i])
+        {
+            return Precompiled::Ptr();
+        }
+    }
+    uint32_t number = fromBigEndian<uint32_t>(_address.ref().cropped(Address::size - 4));
+    if (number <= c_registeredAddressBase ||
+        number - c_registeredAddressBase > m_registeredPrecompiled.size())
+    {
+        return Precompiled::Ptr();
+    }
+    return m_registeredPrecompiled[number - c_registeredAddressBase - 1];
+}
 
 bool ExecutiveContext::isPrecompiled(Address address) const
 {
@@ -88,13 +111,25 @@ Precompiled::Ptr ExecutiveContext::getPrecompiled(Address address) const
 {
     LOG(TRACE) << "PrecompiledEngine getPrecompiled:" << m_blockInfo.hash << " " << address;
 
-    LOG(TRACE) << "address size:" << m_address2Precompiled.size();
+    LOG(TRACE) << "registered size:" << m_registeredPrecompiled.size();
+    if (auto registered = getRegisteredPrecompiled(address))
+    {
+        return registered;
+    }
     auto itPrecompiled = m_address2Precompiled.find(address);
 
     if (itPrecompiled != m_address2Precompiled.end())
     {
         return itPrecompiled->second;
     }
+    if (m_builtinPrecompiled)
+    {
+        itPrecompiled = m_builtinPrecompiled->find(address);
+        if (itPrecompiled != m_builtinPrecompiled->end())
+        {
+            return itPrecompiled->second;
+        }
+    }
 
     return Precompiled::Ptr();
 }
@@ -102,9 +137,7 @@ Precompiled::Ptr ExecutiveContext::getPrecompiled(Address address) const
 std::shared_ptr<storage::Table> ExecutiveContext::getTable(const Address& address)
 {
     std::string tableName = "_contract_data_" + address.hex() + "_";
-    TableFactoryPrecompiled::Ptr tableFactoryPrecompiled =
-        std::dynamic_pointer_cast<TableFactoryPrecompiled>(getPrecompiled(Address(0x1001)));
-    return tableFactoryPrecompiled->getmemoryTableFactory()->openTable(tableName);
+    return m_memoryTableFactory->openTable(tableName);
 }
 
 std::shared_ptr<dev::executive::StateFace> ExecutiveContext::getState()
@@ -118,19 +151,21 @@ void ExecutiveContext::setState(std::shared_ptr<dev::executive::StateFace> state
 
 bool ExecutiveContext::isOrginPrecompiled(Address const& _a) const
 {
-    return m_precompiledContract.count(_a);
+    return m_precompiledContract && m_precompiledContract->count(_a);
 }
 
 std::pair<bool, bytes> ExecutiveContext::executeOrginPrecompiled(
     Address const& _a, bytesConstRef _in) const
 {
-    return m_precompiledContract.at(_a).execute(_in);
+    ++m_precompiledCalls;
+    return m_precompiledContract->at(_a).execute(_in);
 }
 
 void ExecutiveContext::setPrecompiledContract(
     std::unordered_map<Address, PrecompiledContract> const& precompiledContract)
 {
-    m_precompiledContract = precompiledContract;
+    m_precompiledContract =
+        std::make_shared<std::unordered_map<Address, PrecompiledContract>>(precompiledContract);
 }
 
 void ExecutiveContext::dbCommit(Block& block)
@@ -138,3 +173,23 @@ void ExecutiveContext::dbCommit(Block& block)
     m_stateFace->dbCommit(block.header().hash(), block.header().number());
     m_memoryTableFactory->commitDB(block.header().hash(), block.header().number());
 }
+
+void ExecutiveContext::reset()
+{
+    m_address2Precompiled.clear();
+    m_registeredPrecompiled.clear();
+    m_precompiledCalls = 0;
+    m_blockInfo = BlockInfo();
+    m_stateFace.reset();
+    m_builtinPrecompiled.reset();
+    m_precompiledContract.reset();
+    // the state and the precompileds registered in the context are dropped above
+    if (m_memoryTableFactory && m_memoryTableFactory.use_count() == 1)
+    {
+        m_memoryTableFactory->reset();
+    }
+    else
+    {
+        m_memoryTableFactory.reset();
+    }
+}
@@ -50,6 +50,11 @@ class ExecutiveContext : public std::enable_shared_from_this<ExecutiveContext>
 {
 public:
     typedef std::shared_ptr<ExecutiveContext> Ptr;
+    /// registries shared by the contexts, they mustn't be modified once shared
+    typedef std::shared_ptr<const std::unordered_map<Address, Precompiled::Ptr>>
+        PrecompiledRegistry;
+    typedef std::shared_ptr<const std::unordered_map<Address, dev::eth::PrecompiledContract>>
+        PrecompiledContractRegistry;
 
     ExecutiveContext(){};
 
@@ -59,6 +64,10 @@ public:
 
     virtual Address registerPrecompiled(Precompiled::Ptr p);
 
+    /// drop the objects registered by the executed transaction, so the registered addresses of a
+    /// transaction don't depend on the preceding transactions. Only done on the chains of version 1
+    void clearRegisteredPrecompiled();
+
     virtual bool isPrecompiled(Address address) const;
 
     Precompiled::Ptr getPrecompiled(Address address) const;
@@ -68,6 +77,17 @@ public:
         m_address2Precompiled.insert(std::make_pair(address, precompiled));
     }
 
+    /// the precompileds looked up after the ones set or registered in this context, they must
+    /// get the table factory from the context they are called with
+    void setBuiltinPrecompiled(PrecompiledRegistry const& builtinPrecompiled)
+    {
+        m_builtinPrecompiled = builtinPrecompiled;
+    }
+
+    /// the execution rules follow the version of the chain, see dev::eth::c_chainVersion
+    unsigned chainVersion() const { return m_chainVersion; }
+    void setChainVersion(unsigned _chainVersion) { m_chainVersion = _chainVersion; }
+
     BlockInfo blockInfo() { return m_blockInfo; }
     void setBlockInfo(BlockInfo blockInfo) { m_blockInfo = blockInfo; }
 
@@ -84,6 +104,10 @@ public:
 
     void setPrecompiledContract(
         std::unordered_map<Address, dev::eth::PrecompiledContract> const& precompiledContract);
+    void setPrecompiledContract(PrecompiledContractRegistry const& precompiledContract)
+    {
+        m_precompiledContract = precompiledContract;
+    }
 
     void dbCommit(dev::eth::Block& block);
 
@@ -97,13 +121,28 @@ public:
         return m_memoryTableFactory;
     }
 
+    /// the number of the precompiled calls executed in the context
+    uint64_t precompiledCalls() const { return m_precompiledCalls; }
+
+    /// drop everything set since the construction except the table factory, which is reset and
+    /// kept to be reused if nothing else refers to it
+    void reset();
 
 private:
+    /// @returns the registered precompiled of _address, which is its index after the base
+    Precompiled::Ptr getRegisteredPrecompiled(Address const& _address) const;
+
+    static const uint32_t c_registeredAddressBase = 0x10000;
     std::unordered_map<Address, Precompiled::Ptr> m_address2Precompiled;
-    int m_addressCount = 0x10000;
+    /// the tables, entries and conditions registered by the executed transaction, the vector is
+    /// cleared but keeps its capacity for the next transaction
+    std::vector<Precompiled::Ptr> m_registeredPrecompiled;
     BlockInfo m_blockInfo;
     std::shared_ptr<dev::executive::StateFace> m_stateFace;
-    std::unordered_map<Address, dev::eth::PrecompiledContract> m_precompiledContract;
+    PrecompiledRegistry m_builtinPrecompiled;
+    PrecompiledContractRegistry m_precompiledContract;
+    mutable uint64_t m_precompiledCalls = 0;
+    unsigned m_chainVersion = 0;
     std::shared_ptr<dev::storage::MemoryTableFactory> m_memoryTableFactory;
 };
 
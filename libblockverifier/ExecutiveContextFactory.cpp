@@ -9,31 +9,104 @@ using namespace dev;
 using namespace dev::blockverifier;
 using namespace dev::executive;
 
+ExecutiveContextFactory::ExecutiveContextFactory()
+  : m_contextPool(std::make_shared<ContextPool>())
+{
+    auto precompiledContract =
+        std::make_shared<std::unordered_map<Address, dev::eth::PrecompiledContract>>();
+    precompiledContract->insert(std::make_pair(
+        dev::Address(1), dev::eth::PrecompiledContract(
+                             3000, 0, dev::eth::PrecompiledRegistrar::executor("ecrecover"))));
+    precompiledContract->insert(std::make_pair(
+        dev::Address(2), dev::eth::PrecompiledContract(
+                             60, 12, dev::eth::PrecompiledRegistrar::executor("sha256"))));
+    precompiledContract->insert(std::make_pair(
+        dev::Address(3), dev::eth::PrecompiledContract(
+                             600, 120, dev::eth::PrecompiledRegistrar::executor("ripemd160"))));
+    precompiledContract->insert(std::make_pair(
+        dev::Address(4), dev::eth::PrecompiledContract(
+                             15, 3, dev::eth::PrecompiledRegistrar::executor("identity"))));
+    m_precompiledContract = precompiledContract;
+
+    // the builtin precompileds open the tables in the factory of the calling context
+    auto builtinPrecompiled = std::make_shared<std::unordered_map<Address, Precompiled::Ptr>>();
+    builtinPrecompiled->insert(std::make_pair(
+        Address(0x1001), std::make_shared<dev::blockverifier::TableFactoryPrecompiled>()));
+    builtinPrecompiled->insert(
+        std::make_pair(Address(0x1002), std::make_shared<dev::blockverifier::CRUDPrecompiled>()));
+    builtinPrecompiled->insert(
+        std::make_pair(Address(0x1003), std::make_shared<dev::blockverifier::MinerPrecompiled>()));
+    m_builtinPrecompiled = builtinPrecompiled;
+}
+
 void ExecutiveContextFactory::initExecutiveContext(
     BlockInfo blockInfo, h256 stateRoot, ExecutiveContext::Ptr context)
 {
-    // DBFactoryPrecompiled
-    dev::storage::MemoryTableFactory::Ptr memoryTableFactory =
-        std::make_shared<dev::storage::MemoryTableFactory>();
+    setupExecutiveContext(
+        blockInfo, stateRoot, context, std::make_shared<dev::storage::MemoryTableFactory>());
+}
+
+ExecutiveContext::Ptr ExecutiveContextFactory::createExecutiveContext(
+    BlockInfo const& blockInfo, h256 const& stateRoot)
+{
+    std::unique_ptr<ExecutiveContext> pooled;
+    {
+        Guard l(m_contextPool->x_contexts);
+        if (!m_contextPool->contexts.empty())
+        {
+            pooled = std::move(m_contextPool->contexts.back());
+            m_contextPool->contexts.pop_back();
+        }
+    }
+    if (!pooled)
+        pooled.reset(new ExecutiveContext());
+
+    std::weak_ptr<ContextPool> pool = m_contextPool;
+    ExecutiveContext::Ptr context(pooled.release(),
+        [pool](ExecutiveContext* _context) { releaseExecutiveContext(pool, _context); });
+    auto memoryTableFactory = context->getMemoryTableFactory();
+    if (!memoryTableFactory)
+        memoryTableFactory = std::make_shared<dev::storage::MemoryTableFactory>();
+    setupExecutiveContext(blockInfo, stateRoot, context, memoryTableFactory);
+    return context;
+}
+
+void ExecutiveContextFactory::setupExecutiveContext(BlockInfo const& blockInfo,
+    h256 const& stateRoot, ExecutiveContext::Ptr context,
+    dev::storage::MemoryTableFactory::Ptr memoryTableFactory)
+{
     memoryTableFactory->setStateStorage(m_stateStorage);
     memoryTableFactory->setBlockHash(blockInfo.hash);
     memoryTableFactory->setBlockNum(blockInfo.number);
 
-    auto tableFactoryPrecompiled = std::make_shared<dev::blockverifier::TableFactoryPrecompiled>();
-    tableFactoryPrecompiled->setMemoryTableFactory(memoryTableFactory);
-
-    context->setAddress2Precompiled(Address(0x1001), tableFactoryPrecompiled);
-    context->setAddress2Precompiled(
-        Address(0x1002), std::make_shared<dev::blockverifier::CRUDPrecompiled>());
-    context->setAddress2Precompiled(
-        Address(0x1003), std::make_shared<dev::blockverifier::MinerPrecompiled>());
+    context->setBuiltinPrecompiled(m_builtinPrecompiled);
     context->setMemoryTableFactory(memoryTableFactory);
 
     context->setBlockInfo(blockInfo);
+    context->setChainVersion(m_chainVersion);
     context->setPrecompiledContract(m_precompiledContract);
     context->setState(m_stateFactoryInterface->getState(stateRoot, memoryTableFactory));
 }
 
+void ExecutiveContextFactory::releaseExecutiveContext(
+    std::weak_ptr<ContextPool> const& pool, ExecutiveContext* context)
+{
+    std::unique_ptr<ExecutiveContext> released(context);
+    auto contextPool = pool.lock();
+    if (!contextPool)
+        return;
+    released->reset();
+    Guard l(contextPool->x_contexts);
+    if (contextPool->contexts.size() < c_maxPooledContexts)
+        contextPool->contexts.push_back(std::move(released));
+}
+
+size_t ExecutiveContextFactory::pooledContexts()
+{
+    Guard l(m_contextPool->x_contexts);
+    return m_contextPool->contexts.size();
+}
+
 void ExecutiveContextFactory::setStateStorage(dev::storage::Storage::Ptr stateStorage)
 {
     m_stateStorage = stateStorage;
@@ -1,9 +1,12 @@
 #pragma once
 
 #include "ExecutiveContext.h"
+#include <libdevcore/Guards.h>
 #include <libdevcore/OverlayDB.h>
 #include <libexecutive/StateFactoryInterface.h>
 #include <libstorage/Storage.h>
+#include <memory>
+#include <vector>
 namespace dev
 {
 namespace blockverifier
@@ -12,35 +15,49 @@ class ExecutiveContextFactory : public std::enable_shared_from_this<ExecutiveCon
 {
 public:
     typedef std::shared_ptr<ExecutiveContextFactory> Ptr;
-    ExecutiveContextFactory()
-    {
-        m_precompiledContract.insert(std::make_pair(
-            dev::Address(1), dev::eth::PrecompiledContract(
-                                 3000, 0, dev::eth::PrecompiledRegistrar::executor("ecrecover"))));
-        m_precompiledContract.insert(std::make_pair(
-            dev::Address(2), dev::eth::PrecompiledContract(
-                                 60, 12, dev::eth::PrecompiledRegistrar::executor("sha256"))));
-        m_precompiledContract.insert(std::make_pair(
-            dev::Address(3), dev::eth::PrecompiledContract(
-                                 600, 120, dev::eth::PrecompiledRegistrar::executor("ripemd160"))));
-        m_precompiledContract.insert(std::make_pair(
-            dev::Address(4), dev::eth::PrecompiledContract(
-                                 15, 3, dev::eth::PrecompiledRegistrar::executor("identity"))));
-    };
+    ExecutiveContextFactory();
     virtual ~ExecutiveContextFactory(){};
 
     virtual void initExecutiveContext(
         BlockInfo blockInfo, h256 stateRoot, ExecutiveContext::Ptr context);
 
+    /// @returns an initialized context taken from the pool, it's reset and returned to the pool
+    /// when the last reference to it is dropped. Its table factory is reused if the previous
+    /// user of the context didn't keep it
+    virtual ExecutiveContext::Ptr createExecutiveContext(
+        BlockInfo const& blockInfo, h256 const& stateRoot);
+
     virtual void setStateStorage(dev::storage::Storage::Ptr stateStorage);
 
     virtual void setStateFactory(
         std::shared_ptr<dev::executive::StateFactoryInterface> stateFactoryInterface);
 
+    /// the version of the chain the contexts execute the blocks of
+    void setChainVersion(unsigned _chainVersion) { m_chainVersion = _chainVersion; }
+
+    /// the number of released contexts kept for reuse
+    size_t pooledContexts();
+
 private:
+    struct ContextPool
+    {
+        Mutex x_contexts;
+        std::vector<std::unique_ptr<ExecutiveContext>> contexts;
+    };
+
+    void setupExecutiveContext(BlockInfo const& blockInfo, h256 const& stateRoot,
+        ExecutiveContext::Ptr context,
+        dev::storage::MemoryTableFactory::Ptr memoryTableFactory);
+    static void releaseExecutiveContext(
+        std::weak_ptr<ContextPool> const& pool, ExecutiveContext* context);
+
+    static const size_t c_maxPooledContexts = 256;
     dev::storage::Storage::Ptr m_stateStorage;
     std::shared_ptr<dev::executive::StateFactoryInterface> m_stateFactoryInterface;
-    std::unordered_map<Address, dev::eth::PrecompiledContract> m_precompiledContract;
+    ExecutiveContext::PrecompiledContractRegistry m_precompiledContract;
+    ExecutiveContext::PrecompiledRegistry m_builtinPrecompiled;
+    std::shared_ptr<ContextPool> m_contextPool;
+    unsigned m_chainVersion = 0;
 };
 
 }  // namespace blockverifier
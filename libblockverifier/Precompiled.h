@@ -22,12 +22,19 @@
 
 #include <libdevcore/FixedHash.h>
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace dev
 {
 namespace blockverifier
 {
 class ExecutiveContext;
+
+/// a table, or only one key of the table if the key isn't empty
+typedef std::pair<std::string, std::string> ConflictKey;
+typedef std::vector<ConflictKey> ConflictKeys;
+
 class Precompiled : public std::enable_shared_from_this<Precompiled>
 {
 public:
@@ -39,6 +46,10 @@ public:
 
     virtual bytes call(std::shared_ptr<ExecutiveContext> context, bytesConstRef param) = 0;
 
+    /// @returns all keys the call would read or write, calls without common keys can be executed
+    /// concurrently. Empty if the keys can't be known before the call
+    virtual ConflictKeys conflictKeys(bytesConstRef) { return ConflictKeys(); }
+
     virtual uint32_t getParamFunc(bytesConstRef param)
     {
         auto funcBytes = param.cropped(0, 4);
@@ -0,0 +1,132 @@
+/*
+    This file is part of FISCO-BCOS.
+
+    FISCO-BCOS is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FISCO-BCOS is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file TxDAG.cpp
+ *  @record dependency graph of the transactions of a block
+ */
+#include "TxDAG.h"
+#include <map>
+
+using namespace dev;
+using namespace std;
+using namespace dev::blockverifier;
+
+TxDAG::TxDAG(vector<ConflictKeys> const& _conflictKeys)
+  : m_dependents(_conflictKeys.size()), m_inDegree(_conflictKeys.size(), 0)
+{
+    const int64_t none = -1;
+    // the last transaction accessing a whole table, and the ones accessing its keys since then
+    map<string, int64_t> lastTableTx;
+    map<string, map<string, size_t>> lastKeyTx;
+    // the last transaction without conflict keys, and the ones since then
+    int64_t lastBarrier = none;
+    vector<size_t> sinceBarrier;
+
+    for (size_t i = 0; i < _conflictKeys.size(); ++i)
+    {
+        if (_conflictKeys[i].empty())
+        {
+            for (auto j : sinceBarrier)
+                addDependency(j, i);
+            if (sinceBarrier.empty() && lastBarrier != none)
+                addDependency(lastBarrier, i);
+            sinceBarrier.clear();
+            lastTableTx.clear();
+            lastKeyTx.clear();
+            lastBarrier = i;
+            continue;
+        }
+
+        if (lastBarrier != none)
+            addDependency(lastBarrier, i);
+        for (auto const& key : _conflictKeys[i])
+        {
+            auto table = lastTableTx.find(key.first);
+            if (table != lastTableTx.end())
+                addDependency(table->second, i);
+
+            auto& keys = lastKeyTx[key.first];
+            if (key.second.empty())
+            {
+                for (auto const& it : keys)
+                    addDependency(it.second, i);
+                keys.clear();
+                lastTableTx[key.first] = i;
+            }
+            else
+            {
+                auto it = keys.find(key.second);
+                if (it != keys.end())
+                    addDependency(it->second, i);
+                keys[key.second] = i;
+            }
+        }
+        sinceBarrier.push_back(i);
+    }
+
+    for (size_t i = 0; i < m_inDegree.size(); ++i)
+    {
+        if (m_inDegree[i] == 0)
+            m_ready.push(i);
+    }
+}
+
+void TxDAG::addDependency(size_t _from, size_t _to)
+{
+    // the same dependency may be found through several keys
+    if (_from == _to || (!m_dependents[_from].empty() && m_dependents[_from].back() == _to))
+        return;
+    m_dependents[_from].push_back(_to);
+    ++m_inDegree[_to];
+}
+
+int64_t TxDAG::waitReady()
+{
+    UniqueGuard l(x_dag);
+    m_signalled.wait(l, [&]() {
+        return m_stopped || !m_ready.empty() || m_scheduled == m_inDegree.size();
+    });
+    if (m_stopped || m_ready.empty())
+        return -1;
+    size_t index = m_ready.top();
+    m_ready.pop();
+    ++m_scheduled;
+    return index;
+}
+
+void TxDAG::done(size_t _index)
+{
+    Guard l(x_dag);
+    for (auto i : m_dependents[_index])
+    {
+        if (--m_inDegree[i] == 0)
+            m_ready.push(i);
+    }
+    m_signalled.notify_all();
+}
+
+void TxDAG::stop()
+{
+    Guard l(x_dag);
+    m_stopped = true;
+    m_signalled.notify_all();
+}
+
+bool TxDAG::stopped() const
+{
+    Guard l(x_dag);
+    return m_stopped;
+}
@@ -0,0 +1,67 @@
+/*
+    This file is part of FISCO-BCOS.
+
+    FISCO-BCOS is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FISCO-BCOS is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file TxDAG.h
+ *  @record dependency graph of the transactions of a block
+ */
+#pragma once
+
+#include "Precompiled.h"
+#include <libdevcore/Guards.h>
+#include <condition_variable>
+#include <functional>
+#include <queue>
+#include <vector>
+
+namespace dev
+{
+namespace blockverifier
+{
+/**
+ * @brief Transactions sharing a conflict key depend on each other in block order, others are
+ * independent. A transaction without conflict keys depends on all preceding transactions and all
+ * following transactions depend on it. Ready transactions are scheduled lowest index first.
+ */
+class TxDAG
+{
+public:
+    /// @param _conflictKeys the conflict keys of every transaction of the block
+    explicit TxDAG(std::vector<ConflictKeys> const& _conflictKeys);
+
+    /// blocks until a transaction is ready
+    /// @returns the index of the transaction, or -1 if all are scheduled or the DAG is stopped
+    int64_t waitReady();
+    /// mark the transaction executed, the transactions depending on it may become ready
+    void done(size_t _index);
+    /// stop scheduling, waiting threads return -1
+    void stop();
+    bool stopped() const;
+
+private:
+    void addDependency(size_t _from, size_t _to);
+
+    std::vector<std::vector<size_t>> m_dependents;
+    std::vector<size_t> m_inDegree;
+    std::priority_queue<size_t, std::vector<size_t>, std::greater<size_t>> m_ready;
+    size_t m_scheduled = 0;
+    bool m_stopped = false;
+    mutable Mutex x_dag;
+    std::condition_variable m_signalled;
+};
+
+}  // namespace blockverifier
+
+}  // namespace dev
@@ -99,8 +99,13 @@ public:
 
     bool inline shouldResetSealing()
     {
-        return (m_sealing.block.isSealed() ||
-                m_sealing.block.blockHeader().number() <= m_blockChain->number());
+        int64_t number = m_blockChain->number();
+        int64_t sealingNumber = m_sealing.block.blockHeader().number();
+        /// the block sealed on an executed block in pipelined mode is dropped if another block is
+        /// committed, or if the executed block is given up
+        return (m_sealing.block.isSealed() || sealingNumber <= number ||
+                sealingNumber > number + 1 ||
+                m_sealing.block.blockHeader().parentHash() != m_blockChain->numberHash(number));
     }
     /// return the pointer of ConsensusInterface to access common interfaces
     std::shared_ptr<dev::consensus::ConsensusInterface> const consensusEngine()
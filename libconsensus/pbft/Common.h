@@ -45,6 +45,9 @@ enum PBFTPacketType : byte
     SignReqPacket = 0x01,
     CommitReqPacket = 0x02,
     ViewChangeReqPacket = 0x03,
+    CompactPrepareReqPacket = 0x04,
+    TransactionsReqPacket = 0x05,
+    TransactionsPacket = 0x06,
     PBFTPacketCount
 };
 
@@ -356,6 +359,83 @@ struct PrepareReq : public PBFTMsg
     }
 };
 
+/**
+ * @brief The block of a compact prepare request: the block header and the hashes of the
+ * transactions in the order of the block. The header hash is signed by the leader like the
+ * block hash of a full prepare request, the followers rebuild the block from the transactions
+ * in their transaction pool and ask the leader for the missing ones.
+ */
+struct CompactBlock
+{
+    dev::eth::BlockHeader header;
+    h256s transactionHashes;
+
+    CompactBlock() = default;
+    explicit CompactBlock(dev::eth::Block const& _block) : header(_block.blockHeader())
+    {
+        transactionHashes.reserve(_block.transactions().size());
+        for (auto const& tx : _block.transactions())
+            transactionHashes.push_back(tx.sha3());
+    }
+
+    void encode(bytes& _out) const
+    {
+        bytes headerData;
+        header.encode(headerData);
+        RLPStream s;
+        s.appendList(2);
+        s.appendRaw(headerData);
+        s.appendVector(transactionHashes);
+        s.swapOut(_out);
+    }
+
+    /// @throws if the data isn't a compact block
+    void decode(bytesConstRef _data)
+    {
+        RLP rlp(_data);
+        header = dev::eth::BlockHeader(rlp[0].data(), dev::eth::HeaderData);
+        transactionHashes = rlp[1].toVector<h256>(RLP::VeryStrict);
+    }
+};
+
+/**
+ * @brief The transactions of a compact prepare request missing from the transaction pool of a
+ * follower: the request carries the indexes of the transactions in the block, the response the
+ * encoded transactions in the same order. They aren't signed, the followers check the
+ * transactions against the hashes of the signed prepare request.
+ */
+struct TransactionsReq
+{
+    h256 block_hash;
+    std::vector<unsigned> indexes;
+    std::vector<bytes> transactions;
+
+    void encode(bytes& _out) const
+    {
+        RLPStream s;
+        s.appendList(3);
+        s << block_hash;
+        s.appendVector(indexes);
+        s.appendList(transactions.size());
+        for (auto const& tx : transactions)
+            s.appendRaw(tx);
+        s.swapOut(_out);
+    }
+
+    /// @throws if the data isn't a transactions request or response
+    void decode(bytesConstRef _data)
+    {
+        RLP rlp(_data);
+        block_hash = rlp[0].toHash<h256>(RLP::VeryStrict);
+        indexes = rlp[1].toVector<unsigned>(RLP::VeryStrict);
+        RLP const txs = rlp[2];
+        transactions.clear();
+        transactions.reserve(txs.itemCount());
+        for (auto const& tx : txs)
+            transactions.push_back(tx.data().toBytes());
+    }
+};
+
 /// signature request
 struct SignReq : public PBFTMsg
 {
@@ -43,11 +43,19 @@ const std::string PBFTEngine::c_backupMsgDirName = "pbftMsgBackup";
 void PBFTEngine::start()
 {
     initPBFTEnv(3 * getIntervalBlockTime());
+    m_commitPool = std::make_shared<dev::ThreadPool>("PBFTCommit", 1);
     ConsensusEngineBase::start();
     PBFTENGINE_LOG(INFO) << "[#Start PBFTEngine...]" << std::endl;
     PBFTENGINE_LOG(INFO) << "[#ConsensusStatus]:  " << consensusStatus() << std::endl;
 }
 
+void PBFTEngine::stop()
+{
+    ConsensusEngineBase::stop();
+    /// wait for the block being committed
+    m_commitPool.reset();
+}
+
 void PBFTEngine::initPBFTEnv(unsigned view_timeout)
 {
     Guard l(m_mutex);
@@ -93,9 +101,56 @@ bool PBFTEngine::shouldSeal()
         }
         return false;
     }
+    /// the prepareReq of this height has been proposed before the last block was committed
+    if (m_reqCache->rawPrepareCache().height == m_consensusBlockNumber &&
+        m_reqCache->rawPrepareCache().view == m_view)
+        return false;
+    return true;
+}
+
+/**
+ * @brief: pipelined mode: the leader of the next height in view 0 proposes it once the block of
+ *         the current height has been executed, without waiting for the block to be committed
+ * @param o_parentHash: the hash of the executed block of the current height
+ */
+bool PBFTEngine::shouldSealNext(h256& o_parentHash)
+{
+    if (!m_pipeline)
+        return false;
+    Guard l(m_mutex);
+    if (m_cfgErr || m_accountType != NodeAccountType::MinerAccount || m_nodeNum == 0)
+        return false;
+    PrepareReq const& current = m_reqCache->prepareCache();
+    if (current.height != m_consensusBlockNumber || !current.p_execContext)
+        return false;
+    if (m_reqCache->nextRawPrepareCache().height == m_consensusBlockNumber + 1)
+        return false;
+    /// the leader after the current block is committed, when the view is reset to 0
+    if (IDXTYPE(m_consensusBlockNumber % m_nodeNum) != m_idx)
+        return false;
+    o_parentHash = current.block_hash;
     return true;
 }
 
+std::shared_ptr<Block> PBFTEngine::executedBlock(h256 const& _hash)
+{
+    Guard l(m_mutex);
+    if (m_reqCache->prepareCache().block_hash != _hash)
+        return nullptr;
+    std::shared_ptr<Block> block = std::make_shared<Block>();
+    try
+    {
+        block->decode(ref(m_reqCache->prepareCache().block), false);
+    }
+    catch (std::exception const& e)
+    {
+        PBFTENGINE_LOG(WARNING) << "[#executedBlock] Invalid prepare: [EINFO]:  " << e.what()
+                                << std::endl;
+        return nullptr;
+    }
+    return block;
+}
+
 /**
  * @brief: rehandle the unsubmitted committedPrepare
  * @param req: the unsubmitted committed prepareReq
@@ -218,14 +273,30 @@ void PBFTEngine::backupMsg(std::string const& _key, PBFTMsg const& _msg)
 bool PBFTEngine::generatePrepare(Block const& block)
 {
     Guard l(m_mutex);
-    PrepareReq prepare_req(block, m_keyPair, m_view, m_idx);
+    /// the next height in pipelined mode is proposed in the view 0 it is committed in
+    VIEWTYPE view = block.blockHeader().number() > m_consensusBlockNumber ? 0 : m_view;
+    PrepareReq prepare_req(block, m_keyPair, view, m_idx);
     bytes prepare_data;
-    prepare_req.encode(prepare_data);
-    /// broadcast the generated preparePacket
-    bool succ = broadcastMsg(PrepareReqPacket, prepare_req.uniqueKey(), ref(prepare_data));
+    bool succ;
+    if (m_compactPrepare)
+    {
+        /// broadcast the block header and the transaction hashes, the full prepareReq is kept
+        /// in the raw prepare cache to send the transactions missing from the followers
+        PrepareReq compact_req(prepare_req);
+        CompactBlock(block).encode(compact_req.block);
+        compact_req.encode(prepare_data);
+        succ = broadcastMsg(CompactPrepareReqPacket, prepare_req.uniqueKey(), ref(prepare_data));
+    }
+    else
+    {
+        prepare_req.encode(prepare_data);
+        /// broadcast the generated preparePacket
+        succ = broadcastMsg(PrepareReqPacket, prepare_req.uniqueKey(), ref(prepare_data));
+    }
     if (succ)
     {
-        if (block.getTransactionSize() == 0 && m_omitEmptyBlock)
+        if (block.getTransactionSize() == 0 && m_omitEmptyBlock &&
+            block.blockHeader().number() == m_consensusBlockNumber)
         {
             m_timeManager.changeView();
             m_timeManager.m_changeCycle = 0;
@@ -463,7 +534,7 @@ void PBFTEngine::onRecvPBFTMessage(
     bool valid = decodeToRequests(pbft_msg, message, session);
     if (!valid)
         return;
-    if (pbft_msg.packet_id <= ViewChangeReqPacket)
+    if (pbft_msg.packet_id < PBFTPacketCount)
     {
         m_msgQueue.push(pbft_msg);
     }
@@ -502,6 +573,11 @@ void PBFTEngine::handlePrepareMsg(PrepareReq const& prepareReq, std::string cons
         << "/" << prepareReq.view << "/" << prepareReq.height << "/" << m_highestBlock.number()
         << "/" << m_consensusBlockNumber << "/" << endpoint << "/"
         << prepareReq.block_hash.abridged() << "\n";
+    if (isNextPrepare(prepareReq))
+    {
+        handleNextPrepare(prepareReq, endpoint);
+        return;
+    }
     /// check the prepare request is valid or not
     if (!isValidPrepare(prepareReq, oss))
         return;
@@ -549,12 +625,341 @@ void PBFTEngine::handlePrepareMsg(PrepareReq const& prepareReq, std::string cons
 }
 
 
-void PBFTEngine::checkAndCommit()
+void PBFTEngine::handleCompactPrepareMsg(PrepareReq& prepareReq, PBFTMsgPacket const& pbftMsg)
+{
+    if (!decodeToRequests(prepareReq, ref(pbftMsg.data)))
+        return;
+    /// the prepareReq is forwarded by the other miners, so it's received more than once
+    if (m_reqCache->isExistPrepare(prepareReq) || m_reqCache->isExistNextPrepare(prepareReq))
+        return;
+    if (prepareReq.block_hash == m_pendingPrepare.block_hash)
+    {
+        /// the forwarders which rebuilt the block can also serve its transactions
+        if (!m_missingTransactions.empty() &&
+            std::find(m_pendingSources.begin(), m_pendingSources.end(), pbftMsg.node_id) ==
+                m_pendingSources.end())
+            m_pendingSources.push_back(pbftMsg.node_id);
+        return;
+    }
+    CompactBlock compactBlock;
+    if (!decodeToRequests(compactBlock, ref(prepareReq.block)))
+        return;
+    if (compactBlock.header.hash() != prepareReq.block_hash)
+    {
+        PBFTENGINE_LOG(WARNING) << "[#handleCompactPrepareMsg] Invalid block header: [hash/from]:  "
+                                << prepareReq.block_hash.abridged() << "/" << pbftMsg.endpoint
+                                << std::endl;
+        return;
+    }
+    Transactions transactions;
+    auto missing = m_txPool->pendingTransactions(compactBlock.transactionHashes, transactions);
+    if (missing.empty())
+    {
+        handleRebuiltPrepare(prepareReq, compactBlock.header, transactions, pbftMsg.endpoint);
+        return;
+    }
+    /// only ask for the transactions of a valid prepareReq
+    if ((!isNextPrepare(prepareReq) && hasConsensused(prepareReq)) || !checkSign(prepareReq))
+        return;
+    h512 leader = getMinerByIndex(prepareReq.idx);
+    if (leader == h512())
+        return;
+    m_pendingPrepare = prepareReq;
+    m_pendingBlock = std::move(compactBlock);
+    m_pendingTransactions = std::move(transactions);
+    m_missingTransactions.assign(missing.begin(), missing.end());
+    m_pendingEndpoint = pbftMsg.endpoint;
+    m_pendingSources.assign(1, leader);
+    if (pbftMsg.node_id != leader)
+        m_pendingSources.push_back(pbftMsg.node_id);
+    m_pendingRequests = 0;
+    requestMissingTransactions();
+}
+
+void PBFTEngine::requestMissingTransactions()
+{
+    TransactionsReq req;
+    req.block_hash = m_pendingPrepare.block_hash;
+    req.indexes = m_missingTransactions;
+    bytes req_data;
+    req.encode(req_data);
+    /// the leader may have moved its raw prepare on, so the retries go to the forwarders in turn
+    h512 source = m_pendingSources[m_pendingRequests % m_pendingSources.size()];
+    m_service->asyncSendMessageByNodeID(
+        source, transDataToMessage(ref(req_data), TransactionsReqPacket), nullptr);
+    m_pendingRequestTime = utcTime();
+    ++m_pendingRequests;
+    PBFTENGINE_LOG(DEBUG) << "[#requestMissingTransactions] Request missing txs: "
+                             "[hash/number/missing/total/request]:  "
+                          << m_pendingPrepare.block_hash.abridged() << "/"
+                          << m_pendingPrepare.height << "/" << m_missingTransactions.size() << "/"
+                          << m_pendingBlock.transactionHashes.size() << "/" << m_pendingRequests
+                          << std::endl;
+}
+
+void PBFTEngine::checkPendingPrepare()
+{
+    if (m_missingTransactions.empty() ||
+        utcTime() - m_pendingRequestTime < c_transactionsReqInterval)
+        return;
+    /// a prepareReq given up is handled again if it's forwarded later, otherwise the view change
+    /// moves on
+    if (m_pendingRequests >= c_maxTransactionsReqs ||
+        (!isNextPrepare(m_pendingPrepare) && hasConsensused(m_pendingPrepare)))
+    {
+        PBFTENGINE_LOG(WARNING) << "[#checkPendingPrepare] Give up the compact prepare: "
+                                   "[hash/number/requests]:  "
+                                << m_pendingPrepare.block_hash.abridged() << "/"
+                                << m_pendingPrepare.height << "/" << m_pendingRequests << std::endl;
+        clearPendingPrepare();
+        return;
+    }
+    requestMissingTransactions();
+}
+
+void PBFTEngine::clearPendingPrepare()
+{
+    m_pendingPrepare = PrepareReq();
+    m_pendingBlock = CompactBlock();
+    m_pendingTransactions.clear();
+    m_missingTransactions.clear();
+    m_pendingSources.clear();
+}
+
+void PBFTEngine::handleTransactionsReqMsg(PBFTMsgPacket const& pbftMsg)
+{
+    /// only the sealers of the current view are served, the miner list may have changed since the
+    /// request was received
+    if (getIndexByMiner(pbftMsg.node_id) < 0)
+    {
+        PBFTENGINE_LOG(DEBUG) << "[#handleTransactionsReqMsg] Request from non-sealer: [from]:  "
+                              << pbftMsg.endpoint << std::endl;
+        return;
+    }
+    TransactionsReq req;
+    if (!decodeToRequests(req, ref(pbftMsg.data)))
+        return;
+    /// each transaction is sent at most once, so the response is bounded by the block
+    std::sort(req.indexes.begin(), req.indexes.end());
+    req.indexes.erase(std::unique(req.indexes.begin(), req.indexes.end()), req.indexes.end());
+    /// the leader of the next height in pipelined mode serves its raw prepare of the next height
+    PrepareReq const& rawPrepare = m_reqCache->nextRawPrepareCache().block_hash == req.block_hash ?
+                                       m_reqCache->nextRawPrepareCache() :
+                                       m_reqCache->rawPrepareCache();
+    if (rawPrepare.block_hash != req.block_hash)
+    {
+        PBFTENGINE_LOG(DEBUG) << "[#handleTransactionsReqMsg] Unknown block: [hash/from]:  "
+                              << req.block_hash.abridged() << "/" << pbftMsg.endpoint << std::endl;
+        return;
+    }
+    try
+    {
+        /// the transactions are sent as they are encoded in the block
+        RLP transactions = RLP(ref(rawPrepare.block))[1];
+        if (req.indexes.empty() || req.indexes.back() >= transactions.itemCount())
+        {
+            PBFTENGINE_LOG(WARNING) << "[#handleTransactionsReqMsg] Invalid indexes: [hash/from]:  "
+                                    << req.block_hash.abridged() << "/" << pbftMsg.endpoint
+                                    << std::endl;
+            return;
+        }
+        for (auto index : req.indexes)
+            req.transactions.push_back(transactions[index].data().toBytes());
+    }
+    catch (std::exception const& e)
+    {
+        PBFTENGINE_LOG(WARNING) << "[#handleTransactionsReqMsg] Invalid raw prepare: [EINFO]:  "
+                                << e.what() << std::endl;
+        return;
+    }
+    bytes data;
+    req.encode(data);
+    m_service->asyncSendMessageByNodeID(
+        pbftMsg.node_id, transDataToMessage(ref(data), TransactionsPacket), nullptr);
+}
+
+void PBFTEngine::handleTransactionsMsg(PBFTMsgPacket const& pbftMsg)
+{
+    TransactionsReq resp;
+    if (!decodeToRequests(resp, ref(pbftMsg.data)))
+        return;
+    if (m_missingTransactions.empty() || resp.block_hash != m_pendingPrepare.block_hash)
+        return;
+    if (resp.indexes != m_missingTransactions ||
+        resp.transactions.size() != m_missingTransactions.size())
+    {
+        PBFTENGINE_LOG(WARNING) << "[#handleTransactionsMsg] Unrequested txs: [hash/from]:  "
+                                << resp.block_hash.abridged() << "/" << pbftMsg.endpoint
+                                << std::endl;
+        return;
+    }
+    for (size_t i = 0; i < resp.indexes.size(); ++i)
+    {
+        unsigned const index = resp.indexes[i];
+        Transaction transaction;
+        if (!decodeToRequests(transaction, ref(resp.transactions[i])))
+            return;
+        /// the hashes are from the signed block header, the transactions aren't signed
+        if (transaction.sha3() != m_pendingBlock.transactionHashes[index])
+        {
+            PBFTENGINE_LOG(WARNING) << "[#handleTransactionsMsg] Invalid tx: [hash/index/from]:  "
+                                    << resp.block_hash.abridged() << "/" << index << "/"
+                                    << pbftMsg.endpoint << std::endl;
+            return;
+        }
+        m_pendingTransactions[index] = std::move(transaction);
+    }
+    PrepareReq prepareReq = m_pendingPrepare;
+    Transactions transactions = std::move(m_pendingTransactions);
+    m_pendingTransactions.clear();
+    m_missingTransactions.clear();
+    m_pendingSources.clear();
+    handleRebuiltPrepare(prepareReq, m_pendingBlock.header, transactions, m_pendingEndpoint);
+}
+
+/// encode the block rebuilt from the compact prepareReq and handle it like a full prepareReq
+void PBFTEngine::handleRebuiltPrepare(PrepareReq& prepareReq, BlockHeader const& header,
+    Transactions const& transactions, std::string const& endpoint)
+{
+    Block block;
+    block.setBlockHeader(header);
+    block.setTransactions(transactions);
+    try
+    {
+        block.encode(prepareReq.block);
+    }
+    catch (std::exception const& e)
+    {
+        PBFTENGINE_LOG(WARNING) << "[#handleRebuiltPrepare] Invalid block: [EINFO]:  "
+                                << boost::diagnostic_information(e) << std::endl;
+        return;
+    }
+    handlePrepareMsg(prepareReq, endpoint);
+}
+
+/**
+ * @brief: pipelined mode: the prepareReq of the next height is executed on the snapshot of the
+ *         executed block of the current height once the block is executed by this node. The
+ *         leader of the next height is the one in view 0 after the current block is committed.
+ */
+bool PBFTEngine::isNextPrepare(PrepareReq const& req) const
+{
+    return m_pipeline && req.height == m_consensusBlockNumber + 1 && req.view == 0 &&
+           m_reqCache->prepareCache().height == m_consensusBlockNumber &&
+           m_reqCache->prepareCache().p_execContext;
+}
+
+void PBFTEngine::handleNextPrepare(PrepareReq const& prepareReq, std::string const& endpoint)
+{
+    Timer t;
+    std::ostringstream oss;
+    oss << "[#handleNextPrepare] [idx/number/consNum/fromIp/hash]:  " << prepareReq.idx << "/"
+        << prepareReq.height << "/" << m_consensusBlockNumber << "/" << endpoint << "/"
+        << prepareReq.block_hash.abridged() << "\n";
+    if (m_reqCache->isExistNextPrepare(prepareReq))
+        return;
+    if (m_nodeNum == 0 || prepareReq.idx != IDXTYPE(m_consensusBlockNumber % m_nodeNum))
+    {
+        PBFTENGINE_LOG(WARNING) << "[#InvalidNextPrepare] Invalid leader: [INFO]:  " << oss.str();
+        return;
+    }
+    if (!checkSign(prepareReq))
+    {
+        PBFTENGINE_LOG(WARNING) << "[#InvalidNextPrepare] Invalid sig: [INFO]:  " << oss.str();
+        return;
+    }
+    PrepareReq const& current = m_reqCache->prepareCache();
+    Sealing workingSealing;
+    try
+    {
+        Block working_block(prepareReq.block);
+        if (working_block.blockHeader().parentHash() != current.block_hash)
+        {
+            PBFTENGINE_LOG(WARNING) << "[#InvalidNextPrepare] Not on the current block: "
+                                       "[parentHash/currentHash]:  "
+                                    << working_block.blockHeader().parentHash().abridged() << "/"
+                                    << current.block_hash.abridged() << "  [INFO]:  " << oss.str();
+            return;
+        }
+        checkMinerList(working_block);
+        BlockHeader currentHeader(ref(current.block), BlockData);
+        BlockInfo currentInfo{current.block_hash, current.height, currentHeader.stateRoot()};
+        if (!m_nextSnapshot || m_nextSnapshot->blockHash() != current.block_hash)
+            m_nextSnapshot = m_blockVerifier->snapshotState(current.p_execContext, currentInfo);
+        if (m_nextSnapshot)
+            workingSealing.p_execContext =
+                m_blockVerifier->executeChainedBlock(working_block, currentInfo, m_nextSnapshot);
+        workingSealing.block = working_block;
+    }
+    catch (std::exception& e)
+    {
+        PBFTENGINE_LOG(WARNING) << "[#handleNextPrepare] Block execute failed: [EINFO]:  "
+                                << boost::diagnostic_information(e) << "  [INFO]: " << oss.str()
+                                << std::endl;
+        return;
+    }
+    /// the state can't be snapshotted, executed after the current block is committed
+    if (!workingSealing.p_execContext)
+    {
+        m_reqCache->addFuturePrepareCache(prepareReq);
+        return;
+    }
+    PrepareReq sign_prepare(prepareReq, workingSealing, m_keyPair);
+    m_reqCache->addNextPrepareReq(prepareReq, sign_prepare);
+    if (!broadcastSignReq(sign_prepare))
+    {
+        PBFTENGINE_LOG(WARNING) << "[#broadcastSignReq failed] [INFO]:  " << oss.str();
+    }
+    PBFTENGINE_LOG(DEBUG) << "[#handleNextPrepare Succ] [Timecost]:  " << 1000 * t.elapsed()
+                          << "  [INFO]:  " << oss.str();
+}
+
+/// the next height is kept if it is executed on the committed block and its leader is still valid
+void PBFTEngine::promoteNextPrepare()
+{
+    PrepareReq const& next = m_reqCache->nextPrepareCache();
+    if (next.height != m_consensusBlockNumber)
+    {
+        clearNextPrepare();
+        return;
+    }
+    bool valid = m_nextSnapshot && m_nextSnapshot->blockHash() == m_highestBlock.hash() &&
+                 next.view == m_view && isValidLeader(next);
+    if (valid)
+    {
+        ReadGuard l(m_minerListMutex);
+        valid = BlockHeader(ref(next.block), BlockData).sealerList() == m_minerList;
+    }
+    if (!valid)
+    {
+        PBFTENGINE_LOG(INFO) << "[#promoteNextPrepare] Drop the next prepare: [number/hash]:  "
+                             << next.height << "/" << next.block_hash.abridged() << std::endl;
+        clearNextPrepare();
+        return;
+    }
+    PBFTENGINE_LOG(DEBUG) << "[#promoteNextPrepare] [number/hash/sigSize]:  " << next.height << "/"
+                          << next.block_hash.abridged() << "/"
+                          << m_reqCache->getSigCacheSize(next.block_hash) << std::endl;
+    m_reqCache->promoteNextPrepare();
+    m_nextSnapshot.reset();
+    checkAndCommit(true);
+}
+
+/// the contexts executed on the snapshot are dropped with it
+void PBFTEngine::clearNextPrepare()
+{
+    if (m_nextSnapshot)
+        m_nextSnapshot->abort();
+    m_nextSnapshot.reset();
+    m_reqCache->clearNextPrepare();
+}
+
+void PBFTEngine::checkAndCommit(bool _promoted)
 {
     size_t sign_size = m_reqCache->getSigCacheSize(m_reqCache->prepareCache().block_hash);
     /// must be equal to minValidNodes:in case of callback checkAndCommit repeatly in a round of
-    /// PBFT consensus
-    if (sign_size == minValidNodes())
+    /// PBFT consensus, unless the signReqs have been collected before the height is current
+    if (sign_size == minValidNodes() || (_promoted && sign_size > minValidNodes()))
     {
         PBFTENGINE_LOG(TRACE) << "[#checkAndCommit:SignReq enough] [number/sigSize/hash]:  "
                               << m_reqCache->prepareCache().height << "/" << sign_size << "/"
@@ -609,32 +1014,16 @@ void PBFTEngine::checkAndSave()
         /// add sign-list into the block header
         if (m_reqCache->prepareCache().height > m_highestBlock.number())
         {
-            Block block(m_reqCache->prepareCache().block);
-            m_reqCache->generateAndSetSigList(block, minValidNodes());
+            std::shared_ptr<Sealing> sealing = std::make_shared<Sealing>();
+            sealing->block.decode(ref(m_reqCache->prepareCache().block));
+            m_reqCache->generateAndSetSigList(sealing->block, minValidNodes());
+            sealing->p_execContext = m_reqCache->prepareCache().p_execContext;
             PBFTENGINE_LOG(DEBUG) << "[#checkAndSave: Consensus Succ] [number/hash/idx]:  "
                                   << m_reqCache->prepareCache().height << "/"
                                   << m_reqCache->prepareCache().block_hash.abridged() << "/"
                                   << m_reqCache->prepareCache().idx << std::endl;
             /// callback block chain to commit block
-            CommitResult ret = m_blockChain->commitBlock(
-                block, std::shared_ptr<ExecutiveContext>(m_reqCache->prepareCache().p_execContext));
-            PBFTENGINE_LOG(DEBUG) << "[#commitBlock Succ]" << std::endl;
-            /// drop handled transactions
-            if (ret == CommitResult::OK)
-            {
-                dropHandledTransactions(block);
-                PBFTENGINE_LOG(DEBUG) << "[#commitBlock Succ]" << std::endl;
-            }
-            else
-            {
-                PBFTENGINE_LOG(ERROR)
-                    << "[#commitBlock Failed] [highNum/SNum/Shash]:  " << m_highestBlock.number()
-                    << "/" << block.blockHeader().number() << "/"
-                    << block.blockHeader().hash().abridged() << std::endl;
-                /// note blocksync to sync
-                m_blockSync->noteSealingBlockNumber(m_blockChain->number());
-                m_txPool->handleBadBlock(block);
-            }
+            commitBlock(sealing);
             /// clear caches to in case of repeated commit
             resetConfig();
             m_reqCache->clearAllExceptCommitCache();
@@ -652,6 +1041,62 @@ void PBFTEngine::checkAndSave()
     }
 }
 
+void PBFTEngine::commitBlock(std::shared_ptr<Sealing> _sealing)
+{
+    m_committingNumber = _sealing->block.blockHeader().number();
+    if (!m_commitPool)
+    {
+        CommitResult ret = m_blockChain->commitBlock(_sealing->block, _sealing->p_execContext);
+        if (ret == CommitResult::OK)
+            dropHandledTransactions(_sealing->block);
+        onCommitBlock(*_sealing, ret);
+        return;
+    }
+    /// the transactions are dropped on the commit thread too, the commit thread reports the
+    /// block chain update before the result is handled on the consensus thread
+    m_commitPool->enqueue([this, _sealing]() {
+        Timer t;
+        CommitResult ret = m_blockChain->commitBlock(_sealing->block, _sealing->p_execContext);
+        if (ret == CommitResult::OK)
+            dropHandledTransactions(_sealing->block);
+        PBFTENGINE_LOG(DEBUG) << "[#commitBlock] [number/timecost]:  "
+                              << _sealing->block.blockHeader().number() << "/"
+                              << 1000 * t.elapsed() << std::endl;
+        m_commitResults.push(std::make_pair(_sealing, ret));
+        m_signalled.notify_all();
+    });
+}
+
+void PBFTEngine::handleCommitResults()
+{
+    std::pair<bool, std::pair<std::shared_ptr<Sealing>, CommitResult>> ret;
+    while ((ret = m_commitResults.tryPop(0)).first)
+    {
+        Guard l(m_mutex);
+        onCommitBlock(*ret.second.first, ret.second.second);
+    }
+}
+
+void PBFTEngine::onCommitBlock(Sealing const& _sealing, CommitResult _ret)
+{
+    if (_sealing.block.blockHeader().number() == m_committingNumber)
+        m_committingNumber = -1;
+    if (_ret == CommitResult::OK)
+    {
+        PBFTENGINE_LOG(DEBUG) << "[#commitBlock Succ]" << std::endl;
+        return;
+    }
+    PBFTENGINE_LOG(ERROR) << "[#commitBlock Failed] [highNum/SNum/Shash]:  "
+                          << m_highestBlock.number() << "/"
+                          << _sealing.block.blockHeader().number() << "/"
+                          << _sealing.block.blockHeader().hash().abridged() << std::endl;
+    /// note blocksync to sync
+    m_blockSync->noteSealingBlockNumber(m_blockChain->number());
+    m_txPool->handleBadBlock(_sealing.block);
+    /// the next height was executed on the block
+    clearNextPrepare();
+}
+
 /// update the context of PBFT after commit a block into the block-chain
 /// 1. update the highest to new-committed blockHeader
 /// 2. update m_view/m_toView/m_leaderFailed/m_lastConsensusTime/m_consensusBlockNumber
@@ -678,6 +1123,8 @@ void PBFTEngine::reportBlock(Block const& block)
         resetConfig();
         m_reqCache->clearAllExceptCommitCache();
         m_reqCache->delCache(m_highestBlock.hash());
+        if (m_pipeline)
+            promoteNextPrepare();
         PBFTENGINE_LOG(INFO) << "^^^^^^^^^^^^^^^^^^^^^^^^^^^^^Report: number= "
                              << m_highestBlock.number() << ", idx= " << m_highestBlock.sealer()
                              << " , hash= " << m_highestBlock.hash().abridged()
@@ -892,6 +1339,7 @@ void PBFTEngine::checkAndChangeView()
         m_timeManager.m_lastConsensusTime = utcTime();
         m_view = m_toView;
         m_reqCache->triggerViewChange(m_view);
+        clearNextPrepare();
         m_blockSync->noteSealingBlockNumber(m_blockChain->number());
     }
 }
@@ -919,7 +1367,8 @@ void PBFTEngine::checkTimeout()
     bool flag = false;
     {
         Guard l(m_mutex);
-        if (m_timeManager.isTimeout())
+        /// the block agreed on is being written, the timer is reset once it is reported
+        if (!isCommitting() && m_timeManager.isTimeout())
         {
             Timer t;
             m_toView += 1;
@@ -982,6 +1431,21 @@ void PBFTEngine::handleMsg(PBFTMsgPacket const& pbftMsg)
         pbft_msg = req;
         break;
     }
+    case CompactPrepareReqPacket:
+    {
+        PrepareReq prepare_req;
+        handleCompactPrepareMsg(prepare_req, pbftMsg);
+        key = prepare_req.uniqueKey();
+        pbft_msg = prepare_req;
+        break;
+    }
+    /// sent to one node, not forwarded
+    case TransactionsReqPacket:
+        handleTransactionsReqMsg(pbftMsg);
+        return;
+    case TransactionsPacket:
+        handleTransactionsMsg(pbftMsg);
+        return;
     default:
     {
         PBFTENGINE_LOG(WARNING) << "[#handleMsg] Err pbft message: [from]:  " << pbftMsg.node_idx
@@ -1023,7 +1487,9 @@ void PBFTEngine::workLoop()
                 std::unique_lock<std::mutex> l(x_signalled);
                 m_signalled.wait_for(l, std::chrono::milliseconds(5));
             }
+            handleCommitResults();
             checkTimeout();
+            checkPendingPrepare();
             handleFutureBlock();
             collectGarbage();
         }
@@ -1040,6 +1506,13 @@ void PBFTEngine::handleFutureBlock()
 {
     Guard l(m_mutex);
     PrepareReq future_req = m_reqCache->futurePrepareCache();
+    /// pipelined mode: the next height received before the current block was executed
+    if (isNextPrepare(future_req))
+    {
+        m_reqCache->resetFuturePrepare();
+        handleNextPrepare(future_req, "future");
+        return;
+    }
     if (future_req.height == m_consensusBlockNumber && future_req.view == m_view)
     {
         PBFTENGINE_LOG(INFO) << "[#handleFutureBlock] [number/highNum/view/conNum/hash]:  "
@@ -1069,6 +1542,7 @@ const std::string PBFTEngine::consensusStatus() const
     statusObj.push_back(json_spirit::Pair("leaderFailed", m_leaderFailed));
     statusObj.push_back(json_spirit::Pair("cfgErr", m_cfgErr));
     statusObj.push_back(json_spirit::Pair("omitEmptyBlock", m_omitEmptyBlock));
+    statusObj.push_back(json_spirit::Pair("pipeline", m_pipeline));
     status.push_back(statusObj);
     /// get cache-related informations
     m_reqCache->getCacheConsensusStatus(status);
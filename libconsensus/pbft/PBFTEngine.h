@@ -29,6 +29,7 @@
 #include <libconsensus/ConsensusEngineBase.h>
 #include <libdevcore/FileSystem.h>
 #include <libdevcore/LevelDB.h>
+#include <libdevcore/ThreadPool.h>
 #include <libdevcore/concurrent_queue.h>
 #include <sstream>
 
@@ -47,6 +48,9 @@ enum CheckResult
     FUTURE = 2
 };
 using PBFTMsgQueue = dev::concurrent_queue<PBFTMsgPacket>;
+/// the blocks committed on the commit thread and the results of the commits
+using CommitResultQueue =
+    dev::concurrent_queue<std::pair<std::shared_ptr<Sealing>, dev::blockchain::CommitResult>>;
 class PBFTEngine : public ConsensusEngineBase
 {
 public:
@@ -83,6 +87,7 @@ public:
         return m_timeManager.m_intervalBlockTime;
     }
     void start() override;
+    void stop() override;
 
     virtual bool reachBlockIntervalTime()
     {
@@ -106,6 +111,14 @@ public:
     void setStorage(dev::storage::Storage::Ptr storage) { m_storage = storage; }
     const std::string consensusStatus() const override;
     void setOmitEmptyBlock(bool setter) { m_omitEmptyBlock = setter; }
+    void setCompactPrepare(bool _compactPrepare) { m_compactPrepare = _compactPrepare; }
+    void setPipeline(bool _pipeline) { m_pipeline = _pipeline; }
+    /// pipelined mode: whether this node proposes the next height on the executed block of the
+    /// current height before it is committed
+    /// @param o_parentHash: the hash of the executed block of the current height
+    bool shouldSealNext(h256& o_parentHash);
+    /// @returns the executed block of the current height, nullptr if it isn't the given one
+    std::shared_ptr<dev::eth::Block> executedBlock(h256 const& _hash);
 
 protected:
     void workLoop() override;
@@ -145,12 +158,45 @@ protected:
     void handleSignMsg(SignReq& signReq, PBFTMsgPacket const& pbftMsg);
     void handleCommitMsg(CommitReq& commitReq, PBFTMsgPacket const& pbftMsg);
     void handleViewChangeMsg(ViewChangeReq& viewChangeReq, PBFTMsgPacket const& pbftMsg);
+    /// 1. decode the network-received PBFTMsgPacket to a compact prepareReq
+    /// 2. rebuild the block from the transaction pool and handle the prepareReq
+    /// 3. ask the leader for the transactions missing from the pool
+    void handleCompactPrepareMsg(PrepareReq& prepareReq, PBFTMsgPacket const& pbftMsg);
+    /// send the transactions of the raw prepareReq asked for by a follower
+    void handleTransactionsReqMsg(PBFTMsgPacket const& pbftMsg);
+    /// fill the missing transactions of the pending compact prepareReq
+    void handleTransactionsMsg(PBFTMsgPacket const& pbftMsg);
+    void handleRebuiltPrepare(PrepareReq& prepareReq, dev::eth::BlockHeader const& header,
+        dev::eth::Transactions const& transactions, std::string const& endpoint);
+    /// ask the next source of the pending compact prepareReq for its missing transactions
+    void requestMissingTransactions();
+    /// re-request the missing transactions that haven't arrived in time, and give up the pending
+    /// compact prepareReq after the retries or once it's consensused
+    void checkPendingPrepare();
+    void clearPendingPrepare();
     void handleMsg(PBFTMsgPacket const& pbftMsg);
     void catchupView(ViewChangeReq const& req, std::ostringstream& oss);
-    void checkAndCommit();
+    /// @param _promoted: the signReqs of the pipelined next height may be enough already
+    void checkAndCommit(bool _promoted = false);
+    /// pipelined mode: whether the prepareReq of the next height can be executed on the executed
+    /// block of the current height
+    bool isNextPrepare(PrepareReq const& req) const;
+    /// pipelined mode: execute the prepareReq of the next height on the snapshot of the executed
+    /// block of the current height and broadcast its signReq
+    void handleNextPrepare(PrepareReq const& prepareReq, std::string const& endpoint);
+    /// pipelined mode: make the next height the current one after the current block is committed
+    void promoteNextPrepare();
+    void clearNextPrepare();
 
     /// if collect >= 2/3 SignReq and CommitReq, then callback this function to commit block
     void checkAndSave();
+    /// commit the block on the commit thread, or on this thread before the engine is started
+    void commitBlock(std::shared_ptr<Sealing> _sealing);
+    /// handle the results of the blocks committed on the commit thread
+    void handleCommitResults();
+    void onCommitBlock(Sealing const& _sealing, dev::blockchain::CommitResult _ret);
+    /// a block agreed on is being written to the block chain
+    bool isCommitting() const { return m_committingNumber > m_highestBlock.number(); }
     void checkAndChangeView();
 
 protected:
@@ -431,6 +477,23 @@ protected:
 
     /// whether to omit empty block
     bool m_omitEmptyBlock = true;
+    /// whether to broadcast the prepareReq as the block header and the transaction hashes
+    bool m_compactPrepare = false;
+    /// the compact prepareReq waiting for the transactions missing from the transaction pool
+    PrepareReq m_pendingPrepare;
+    CompactBlock m_pendingBlock;
+    dev::eth::Transactions m_pendingTransactions;
+    std::vector<unsigned> m_missingTransactions;
+    std::string m_pendingEndpoint;
+    /// the leader and the miners which forwarded the pending prepareReq, asked in turn
+    std::vector<h512> m_pendingSources;
+    /// the time and the number of the requests of the missing transactions
+    uint64_t m_pendingRequestTime = 0;
+    unsigned m_pendingRequests = 0;
+    /// whether to propose and execute the next height before the current block is committed
+    bool m_pipeline = false;
+    /// the snapshot of the executed block of the current height the next height is executed on
+    dev::storage::ChainedStorage::Ptr m_nextSnapshot;
     // backup msg
     std::shared_ptr<dev::db::LevelDB> m_backupDB = nullptr;
 
@@ -438,6 +501,9 @@ protected:
     static const std::string c_backupKeyCommitted;
     static const std::string c_backupMsgDirName;
     static const unsigned c_PopWaitSeconds = 5;
+    /// milliseconds to wait for the missing transactions before asking again
+    static const unsigned c_transactionsReqInterval = 500;
+    static const unsigned c_maxTransactionsReqs = 5;
 
     std::shared_ptr<PBFTBroadcastCache> m_broadCastCache;
     std::shared_ptr<PBFTReqCache> m_reqCache;
@@ -452,6 +518,12 @@ protected:
 
     /// the block number that update the miner list
     int64_t m_lastObtainMinerNum = 0;
+
+    /// the blocks are committed in order on a dedicated thread, so that the messages are still
+    /// handled and the timeouts checked while the block is written
+    CommitResultQueue m_commitResults;
+    int64_t m_committingNumber = -1;
+    dev::ThreadPool::Ptr m_commitPool;
 };
 }  // namespace consensus
 }  // namespace dev
@@ -197,6 +197,8 @@ void PBFTReqCache::getCacheConsensusStatus(json_spirit::Array& status_array) con
     getCacheStatus(status_array, "committedPrepareCache", m_committedPrepareCache);
     /// future prepare cache
     getCacheStatus(status_array, "futureCache", m_futurePrepareCache);
+    /// prepare cache of the next height
+    getCacheStatus(status_array, "nextPrepareCache", m_nextPrepareCache);
     /// signCache
     getCollectedCacheStatus(status_array, "signCache", m_signCache);
     getCollectedCacheStatus(status_array, "commitCache", m_commitCache);
@@ -44,6 +44,12 @@ public:
         return m_rawPrepareCache.block_hash == req.block_hash;
     }
 
+    /// specified prepareRequest exists in the raw-next-prepare-cache or not?
+    inline bool isExistNextPrepare(PrepareReq const& req)
+    {
+        return m_nextRawPrepareCache.block_hash == req.block_hash;
+    }
+
     /// specified SignReq exists in the sign-cache or not?
     inline bool isExistSign(SignReq const& req)
     {
@@ -94,6 +100,8 @@ public:
     inline PrepareReq const& committedPrepareCache() { return m_committedPrepareCache; }
     PrepareReq* mutableCommittedPrepareCache() { return &m_committedPrepareCache; }
     inline PrepareReq const& futurePrepareCache() { return m_futurePrepareCache; }
+    inline PrepareReq const& nextRawPrepareCache() { return m_nextRawPrepareCache; }
+    inline PrepareReq const& nextPrepareCache() { return m_nextPrepareCache; }
     /// add specified raw-prepare-request into the raw-prepare-cache
     /// reset the prepare-cache
     inline void addRawPrepare(PrepareReq const& req)
@@ -113,6 +121,28 @@ public:
         removeInvalidSignCache(req.block_hash, req.view);
         removeInvalidCommitCache(req.block_hash, req.view);
     }
+    /// pipelined mode: add the prepare request of the next height, executed on the executed block
+    /// of the current height, and its raw prepare request
+    inline void addNextPrepareReq(PrepareReq const& rawReq, PrepareReq const& req)
+    {
+        m_nextRawPrepareCache = rawReq;
+        m_nextPrepareCache = req;
+        PBFTReqCache_LOG(DEBUG) << "[addNextPrepareReq] [height/idx/hash]:" << req.height << "/"
+                                << req.idx << "/" << req.block_hash.abridged();
+    }
+    /// pipelined mode: the next height becomes the current one after the current block is
+    /// committed, the signReqs and commitReqs collected for it are kept
+    inline void promoteNextPrepare()
+    {
+        m_rawPrepareCache = m_nextRawPrepareCache;
+        addPrepareReq(m_nextPrepareCache);
+        clearNextPrepare();
+    }
+    inline void clearNextPrepare()
+    {
+        m_nextRawPrepareCache = PrepareReq();
+        m_nextPrepareCache = PrepareReq();
+    }
     /// add specified signReq to the sign-cache
     inline void addSignReq(SignReq const& req) { m_signCache[req.block_hash][req.sig.hex()] = req; }
     /// add specified commit cache to the commit-cache
@@ -179,6 +209,7 @@ public:
         m_prepareCache.clear();
         m_signCache.clear();
         m_commitCache.clear();
+        clearNextPrepare();
         removeInvalidViewChange(curView);
     }
     /// delete requests cached in m_signCache, m_commitCache and m_prepareCache according to hash
@@ -197,7 +228,14 @@ public:
     inline void clearAllExceptCommitCache()
     {
         m_prepareCache.clear();
-        m_signCache.clear();
+        /// keep the signReqs of the next height in pipelined mode
+        for (auto it = m_signCache.begin(); it != m_signCache.end();)
+        {
+            if (it->first != m_nextPrepareCache.block_hash)
+                it = m_signCache.erase(it);
+            else
+                it++;
+        }
         m_recvViewChangeReq.clear();
     }
 
@@ -320,6 +358,10 @@ private:
     PrepareReq m_committedPrepareCache;
     /// cache for the future prepare cache
     PrepareReq m_futurePrepareCache;
+    /// pipelined mode: cache for the raw prepare request of the next height
+    PrepareReq m_nextRawPrepareCache;
+    /// pipelined mode: cache for the executed prepare request of the next height
+    PrepareReq m_nextPrepareCache;
 };
 }  // namespace consensus
 }  // namespace dev
@@ -41,6 +41,10 @@ namespace consensus
 {
 void PBFTSealer::handleBlock()
 {
+    /// the empty blocks aren't proposed on a block not committed yet
+    if (m_sealing.block.getTransactionSize() == 0 &&
+        m_sealing.block.blockHeader().number() > m_blockChain->number() + 1)
+        return;
     setBlock();
     PBFTSEALER_LOG(INFO) << "+++++++++++++++++++++++++++ [#Generating seal on]:  "
                          << "[blockNumber/txNum/hash]:  " << m_sealing.block.header().number()
@@ -64,6 +68,11 @@ void PBFTSealer::handleBlock()
 void PBFTSealer::setBlock()
 {
     resetSealingHeader(m_sealing.block.header());
+    if (m_sealing.block.header().number() > m_blockChain->number() + 1)
+    {
+        m_sealing.block.header().setTimestamp(
+            std::max(m_parentTimestamp + 1, m_sealing.block.header().timestamp()));
+    }
     m_sealing.block.calTransactionRoot();
 }
 
@@ -76,7 +85,43 @@ bool PBFTSealer::shouldSeal()
 {
     /// LOG(DEBUG)<<"#### Sealer::shouldSeal():"<<Sealer::shouldSeal();
     /// LOG(DEBUG)<<"#### m_pbftEngine->shouldSeal:"<<m_pbftEngine->shouldSeal();
-    return Sealer::shouldSeal() && m_pbftEngine->shouldSeal();
+    if (Sealer::shouldSeal() && m_pbftEngine->shouldSeal())
+        return true;
+    /// the block proposed for the current height is sealed
+    return shouldSealNext() && Sealer::shouldSeal();
+}
+
+/**
+ * @brief: pipelined mode: seal the next height on the executed block of the current height
+ *         before it is committed, the transactions of the executed block aren't sealed again
+ */
+bool PBFTSealer::shouldSealNext()
+{
+    h256 parentHash;
+    if (!m_pbftEngine->shouldSealNext(parentHash))
+        return false;
+    DEV_WRITE_GUARDED(x_sealing)
+    {
+        if (m_sealing.block.blockHeader().parentHash() == parentHash)
+            return true;
+        /// transactions of the current height have been loaded to the sealing block
+        if (!m_sealing.block.isSealed() && m_sealing.block.getTransactionSize() > 0)
+            return false;
+        auto parent = m_pbftEngine->executedBlock(parentHash);
+        if (!parent)
+            return false;
+        m_sealing.block.resetCurrentBlock(parent->header());
+        m_sealing.m_transactionSet.clear();
+        for (auto const& tx : parent->transactions())
+            m_sealing.m_transactionSet.insert(tx.sha3());
+        m_sealing.p_execContext = nullptr;
+        m_parentTimestamp = parent->header().timestamp();
+        PBFTSEALER_LOG(DEBUG) << "[#shouldSealNext] Seal on the executed block: "
+                                 "[number/parentHash]:  "
+                              << m_sealing.block.blockHeader().number() << "/"
+                              << parentHash.abridged() << std::endl;
+    }
+    return true;
 }
 
 uint64_t PBFTSealer::calculateMaxPackTxNum()
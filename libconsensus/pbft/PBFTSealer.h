@@ -76,9 +76,12 @@ protected:
 
 private:
     void setBlock();
+    bool shouldSealNext();
 
 protected:
     std::shared_ptr<PBFTEngine> m_pbftEngine;
+    /// timestamp of the executed block the next height is sealed on in pipelined mode
+    uint64_t m_parentTimestamp = 0;
 };
 }  // namespace consensus
 }  // namespace dev
@@ -0,0 +1,284 @@
+/*
+    This file is part of FISCO-BCOS.
+
+    FISCO-BCOS is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FISCO-BCOS is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file ABICodec.h
+ * @record contract ABI codec of the precompiled calls, decoding in place
+ */
+
+#pragma once
+
+#include <libdevcore/Common.h>
+#include <libdevcore/CommonData.h>
+#include <libdevcore/FixedHash.h>
+#include <cstring>
+#include <vector>
+
+namespace dev
+{
+namespace eth
+{
+/// a string parameter decoded in place, valid as long as the decoded call data
+typedef vector_ref<char const> stringConstRef;
+
+/**
+ * @brief The layout of a parameter type in the contract ABI: the 32-byte slots it takes in the
+ * head and, for the dynamic types, the length-prefixed data it takes in the tail. The codec
+ * decodes and encodes the same bytes as ContractABI, but is resolved at compile time from the
+ * parameter types instead of building a vector of bytes per parameter.
+ */
+template <class T>
+struct ABIType;
+
+template <>
+struct ABIType<u256>
+{
+    static const size_t slots = 1;
+    static void decode(bytesConstRef _data, size_t _head, u256& o_t)
+    {
+        o_t = fromBigEndian<u256>(_data.cropped(_head, 32));
+    }
+    static size_t tailSize(u256 const&) { return 0; }
+    static void encode(u256 const& _t, byte* _head, byte*) { h256(_t).ref().copyTo({_head, 32}); }
+};
+
+template <>
+struct ABIType<u160>
+{
+    static const size_t slots = 1;
+    static void decode(bytesConstRef _data, size_t _head, u160& o_t)
+    {
+        o_t = fromBigEndian<u160>(_data.cropped(_head + 12, 20));
+    }
+    static size_t tailSize(u160 const&) { return 0; }
+    static void encode(u160 const& _t, byte* _head, byte*)
+    {
+        h160(_t).ref().copyTo({_head + 12, 20});
+    }
+};
+
+/// right aligned in its slot like the uint the hash converts to, e.g. an address
+template <unsigned N>
+struct ABIType<FixedHash<N>>
+{
+    static_assert(N <= 32, "Parameter sizes must be at most 32 bytes.");
+    static const size_t slots = 1;
+    static void decode(bytesConstRef _data, size_t _head, FixedHash<N>& o_t)
+    {
+        _data.cropped(_head + 32 - N, N).populate(o_t.ref());
+    }
+    static size_t tailSize(FixedHash<N> const&) { return 0; }
+    static void encode(FixedHash<N> const& _t, byte* _head, byte*)
+    {
+        _t.ref().copyTo({_head + 32 - N, N});
+    }
+};
+
+template <>
+struct ABIType<bool>
+{
+    static const size_t slots = 1;
+    static void decode(bytesConstRef _data, size_t _head, bool& o_t)
+    {
+        o_t = fromBigEndian<u256>(_data.cropped(_head, 32)) > 0;
+    }
+    static size_t tailSize(bool) { return 0; }
+    static void encode(bool _t, byte* _head, byte*) { _head[31] = _t ? 1 : 0; }
+};
+
+template <>
+struct ABIType<byte>
+{
+    static const size_t slots = 1;
+    static void decode(bytesConstRef _data, size_t _head, byte& o_t)
+    {
+        o_t = fromBigEndian<byte>(_data.cropped(_head + 31, 1));
+    }
+    static size_t tailSize(byte) { return 0; }
+    static void encode(byte _t, byte* _head, byte*) { _head[31] = _t; }
+};
+
+template <size_t N>
+struct ABIType<std::array<char, N>>
+{
+    static_assert(N % 32 == 0, "Fixed strings must take whole slots.");
+    static const size_t slots = N / 32;
+    static void decode(bytesConstRef _data, size_t _head, std::array<char, N>& o_t)
+    {
+        _data.cropped(_head, N).populate(bytesRef((byte*)o_t.data(), N));
+    }
+    static size_t tailSize(std::array<char, N> const&) { return 0; }
+    static void encode(std::array<char, N> const& _t, byte* _head, byte*)
+    {
+        std::memcpy(_head, _t.data(), N);
+    }
+};
+
+/// the head holds the offset of the data from the first parameter, the tail holds the length and
+/// the data padded to whole slots
+template <>
+struct ABIType<stringConstRef>
+{
+    static const size_t slots = 1;
+    static void decode(bytesConstRef _data, size_t _head, stringConstRef& o_t)
+    {
+        u256 offset = fromBigEndian<u256>(_data.cropped(_head, 32));
+        u256 len = fromBigEndian<u256>(_data.cropped(static_cast<size_t>(offset), 32));
+        auto stringData =
+            _data.cropped(static_cast<size_t>(offset) + 32, static_cast<size_t>(len));
+        o_t = stringConstRef((char const*)stringData.data(), stringData.size());
+    }
+    static size_t tailSize(stringConstRef const& _t) { return 32 + (_t.size() + 31) / 32 * 32; }
+    static void encode(stringConstRef const& _t, byte* _head, byte* _tail)
+    {
+        h256(u256(_t.size())).ref().copyTo({_tail, 32});
+        std::memcpy(_tail + 32, _t.data(), _t.size());
+    }
+};
+
+template <>
+struct ABIType<std::string>
+{
+    static const size_t slots = 1;
+    static size_t tailSize(std::string const& _t) { return 32 + (_t.size() + 31) / 32 * 32; }
+    static void encode(std::string const& _t, byte* _head, byte* _tail)
+    {
+        ABIType<stringConstRef>::encode(stringConstRef(&_t), _head, _tail);
+    }
+};
+
+/// encodes _t at _head in _out and its dynamic data at io_tail, which is moved past the data
+template <class T>
+inline void encodeABIItem(T const& _t, byte* _out, size_t _head, size_t& io_tail)
+{
+    size_t const tailSize = ABIType<T>::tailSize(_t);
+    ABIType<T>::encode(_t, _out + _head, _out + io_tail);
+    if (tailSize)
+        h256(io_tail).ref().copyTo({_out + _head, 32});
+    io_tail += tailSize;
+}
+
+/// the tail holds the length and the items laid out like parameters, so the offsets of dynamic
+/// items are from the first item
+template <class T>
+struct ABIType<std::vector<T>>
+{
+    static const size_t slots = 1;
+    static void decode(bytesConstRef _data, size_t _head, std::vector<T>& o_t)
+    {
+        u256 offset = fromBigEndian<u256>(_data.cropped(_head, 32));
+        u256 len = fromBigEndian<u256>(_data.cropped(static_cast<size_t>(offset), 32));
+        auto items = _data.cropped(static_cast<size_t>(offset) + 32);
+        // the items take their slots at least, a longer array is out of range and not allocated
+        if (len > items.size() / (ABIType<T>::slots * 32))
+            len = 0;
+        o_t.resize(static_cast<size_t>(len));
+        for (size_t i = 0; i < o_t.size(); ++i)
+            ABIType<T>::decode(items, i * ABIType<T>::slots * 32, o_t[i]);
+    }
+    static size_t tailSize(std::vector<T> const& _t)
+    {
+        size_t size = 32 + _t.size() * ABIType<T>::slots * 32;
+        for (auto const& item : _t)
+            size += ABIType<T>::tailSize(item);
+        return size;
+    }
+    static void encode(std::vector<T> const& _t, byte*, byte* _tail)
+    {
+        h256(u256(_t.size())).ref().copyTo({_tail, 32});
+        size_t itemTail = _t.size() * ABIType<T>::slots * 32;
+        for (size_t i = 0; i < _t.size(); ++i)
+            encodeABIItem(_t[i], _tail + 32, i * ABIType<T>::slots * 32, itemTail);
+    }
+};
+
+template <class... T>
+struct ABISlots;
+
+template <>
+struct ABISlots<>
+{
+    static const size_t value = 0;
+};
+
+template <class T, class... U>
+struct ABISlots<T, U...>
+{
+    static const size_t value = ABIType<T>::slots + ABISlots<U...>::value;
+};
+
+/**
+ * @brief Decodes the parameters of a call in place and encodes its return values into one
+ * buffer, the types are given by the arguments, e.g. for select(string,address):
+ *     stringConstRef key;
+ *     Address condition;
+ *     ABICodec::decode(data, key, condition);
+ * The strings aren't copied out of the call data, the arrays are decoded into vectors of their
+ * items, and the output is sized once from the head slots and the lengths of the dynamic data.
+ * Out of range parameters are decoded as zero or empty, like ContractABI does.
+ */
+class ABICodec
+{
+public:
+    template <class... T>
+    static void decode(bytesConstRef _data, T&... o_t)
+    {
+        decodeAux(_data, 0, o_t...);
+    }
+
+    template <class... T>
+    static size_t encodedSize(T const&... _t)
+    {
+        return ABISlots<T...>::value * 32 + tailSize(_t...);
+    }
+
+    /// o_out is overwritten, so that its capacity is reused
+    template <class... T>
+    static void encode(bytes& o_out, T const&... _t)
+    {
+        o_out.assign(encodedSize(_t...), 0);
+        encodeAux(o_out.data(), 0, ABISlots<T...>::value * 32, _t...);
+    }
+
+private:
+    static void decodeAux(bytesConstRef, size_t) {}
+
+    template <class T, class... U>
+    static void decodeAux(bytesConstRef _data, size_t _head, T& o_t, U&... o_u)
+    {
+        ABIType<T>::decode(_data, _head, o_t);
+        decodeAux(_data, _head + ABIType<T>::slots * 32, o_u...);
+    }
+
+    static size_t tailSize() { return 0; }
+
+    template <class T, class... U>
+    static size_t tailSize(T const& _t, U const&... _u)
+    {
+        return ABIType<T>::tailSize(_t) + tailSize(_u...);
+    }
+
+    static void encodeAux(byte*, size_t, size_t) {}
+
+    template <class T, class... U>
+    static void encodeAux(byte* _out, size_t _head, size_t _tail, T const& _t, U const&... _u)
+    {
+        encodeABIItem(_t, _out, _head, _tail);
+        encodeAux(_out, _head + ABIType<T>::slots * 32, _tail, _u...);
+    }
+};
+
+}  // namespace eth
+}  // namespace dev
@@ -151,7 +151,7 @@ void Block::calReceiptRoot(bool update) const
  * @brief : decode specified data of block into Block class
  * @param _block : the specified data of block
  */
-void Block::decode(bytesConstRef _block_bytes)
+void Block::decode(bytesConstRef _block_bytes, bool _recoverSenders)
 {
     /// no try-catch to throw exceptions directly
     /// get RLP of block
@@ -163,8 +163,11 @@ void Block::decode(bytesConstRef _block_bytes)
     m_transactions.resize(transactions_rlp.itemCount());
     for (size_t i = 0; i < transactions_rlp.itemCount(); i++)
     {
-        m_transactions[i].decode(transactions_rlp[i]);
+        m_transactions[i].decode(transactions_rlp[i], CheckTransaction::Cheap);
     }
+    /// recover the senders concurrently instead of one by one when decoding
+    if (_recoverSenders)
+        recoverSenders(m_transactions);
     /// get transactionReceipt list
     RLP transactionReceipts_rlp = block_rlp[2];
     m_transactionReceipts.resize(transactionReceipts_rlp.itemCount());
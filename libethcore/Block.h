@@ -69,7 +69,8 @@ public:
     void encode(bytes& _out) const;
 
     ///-----decode functions
-    void decode(bytesConstRef _block);
+    /// the senders are left to be recovered on demand if _recoverSenders is false
+    void decode(bytesConstRef _block, bool _recoverSenders = true);
 
     /// @returns the RLP serialisation of this block.
     bytes rlp() const
@@ -43,6 +43,7 @@ const unsigned c_BlockFieldSize = 4;
 
 const unsigned c_databaseVersion =
     c_databaseBaseVersion + (c_databaseVersionModifier << 8) + (23 << 9);
+const unsigned c_chainVersion = 1;
 
 Address toAddress(std::string const& _s)
 {
@@ -54,6 +54,9 @@ extern const unsigned c_minorProtocolVersion;
 
 /// Current database version.
 extern const unsigned c_databaseVersion;
+/// Version of the state layout and the execution rules of the chains created by this node, a chain
+/// keeps the version of its genesis block. The chains created without a version are version 0.
+extern const unsigned c_chainVersion;
 extern const unsigned c_BlockFieldSize;
 /// Convert the given string into an address.
 Address toAddress(std::string const& _s);
@@ -85,6 +85,9 @@ DEV_SIMPLE_EXCEPTION_RLP(ErrorBlockHash);
 DEV_SIMPLE_EXCEPTION(InvalidBlockDownloadQueuePiorityInput);
 DEV_SIMPLE_EXCEPTION(InvalidSyncPeerCreation);
 
+/// call related
+DEV_SIMPLE_EXCEPTION(TooManyPendingCalls);
+
 /// common exceptions
 DEV_SIMPLE_EXCEPTION(InvalidNonce);
 DEV_SIMPLE_EXCEPTION(InvalidSignature);
@@ -0,0 +1,97 @@
+/*
+    This file is part of FISCO-BCOS.
+
+    FISCO-BCOS is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FISCO-BCOS is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file SenderCache.h
+ *  @record process-wide cache of the recovered transaction senders
+ */
+
+#pragma once
+
+#include <libdevcore/Address.h>
+#include <libdevcore/FixedHash.h>
+#include <libdevcore/Guards.h>
+#include <list>
+#include <unordered_map>
+
+namespace dev
+{
+namespace eth
+{
+/**
+ * @brief Thread-safe LRU cache from the hash of a signed transaction to its sender.
+ * The hash covers the signature, so an entry never becomes stale. A transaction verified when
+ * it is imported into the txpool doesn't recover its sender again when it is decoded from a
+ * block. The least recently used sender is evicted once the cache is full.
+ */
+class SenderCache
+{
+public:
+    /// @returns a zero address if the sender isn't cached
+    Address get(h256 const& _txHash)
+    {
+        Guard g(x_cache);
+        auto it = m_cache.find(_txHash);
+        if (it == m_cache.end())
+            return Address();
+        m_lru.splice(m_lru.begin(), m_lru, it->second);
+        return it->second->second;
+    }
+
+    void store(h256 const& _txHash, Address const& _sender)
+    {
+        Guard g(x_cache);
+        if (m_cache.count(_txHash))
+            return;
+        m_lru.emplace_front(_txHash, _sender);
+        m_cache[_txHash] = m_lru.begin();
+        while (m_lru.size() > m_maxSize)
+        {
+            m_cache.erase(m_lru.back().first);
+            m_lru.pop_back();
+        }
+    }
+
+    void setMaxSize(size_t _maxSize)
+    {
+        Guard g(x_cache);
+        m_maxSize = _maxSize;
+    }
+
+    void clear()
+    {
+        Guard g(x_cache);
+        m_lru.clear();
+        m_cache.clear();
+    }
+
+    static SenderCache& instance()
+    {
+        static SenderCache cache;
+        return cache;
+    }
+
+private:
+    typedef std::list<std::pair<h256, Address>> LRUList;
+
+    static const size_t c_defaultMaxSize = 200000;
+    Mutex x_cache;
+    LRUList m_lru;
+    std::unordered_map<h256, LRUList::iterator> m_cache;
+    size_t m_maxSize = c_defaultMaxSize;
+};
+
+}  // namespace eth
+}  // namespace dev
@@ -21,9 +21,14 @@
 
 #include "Transaction.h"
 #include "EVMSchedule.h"
+#include "SenderCache.h"
+#include <libdevcore/Guards.h>
+#include <libdevcore/ThreadPool.h>
 #include <libdevcore/vector_ref.h>
 #include <libdevcrypto/Common.h>
 #include <libethcore/Exceptions.h>
+#include <condition_variable>
+#include <thread>
 
 using namespace std;
 using namespace dev;
@@ -104,14 +109,50 @@ Address const& Transaction::sender() const
         if (!m_vrs)
             BOOST_THROW_EXCEPTION(TransactionIsUnsigned());
 
-        auto p = recover(*m_vrs, sha3(WithoutSignature));
-        if (!p)
-            BOOST_THROW_EXCEPTION(InvalidSignature());
-        m_sender = right160(dev::sha3(bytesConstRef(p.data(), sizeof(p))));
+        h256 hash = sha3(WithSignature);
+        m_sender = SenderCache::instance().get(hash);
+        if (!m_sender)
+        {
+            auto p = recover(*m_vrs, sha3(WithoutSignature));
+            if (!p)
+                BOOST_THROW_EXCEPTION(InvalidSignature());
+            m_sender = right160(dev::sha3(bytesConstRef(p.data(), sizeof(p))));
+            SenderCache::instance().store(hash, m_sender);
+        }
     }
     return m_sender;
 }
 
+void dev::eth::recoverSenders(Transactions const& _transactions, bool _throwInvalid)
+{
+    static size_t const c_threadNum = max(thread::hardware_concurrency(), 1u);
+    static ThreadPool s_threadPool("SenderRecovery", c_threadNum);
+
+    // each task recovers every taskNum-th transaction, failures are thrown in order below
+    size_t taskNum = min(c_threadNum, _transactions.size());
+    size_t pending = taskNum;
+    Mutex x_pending;
+    condition_variable pendingDone;
+    for (size_t task = 0; task < taskNum; ++task)
+    {
+        s_threadPool.enqueue([&, task]() {
+            for (size_t i = task; i < _transactions.size(); i += taskNum)
+                _transactions[i].safeSender();
+            Guard l(x_pending);
+            if (--pending == 0)
+                pendingDone.notify_all();
+        });
+    }
+    {
+        UniqueGuard l(x_pending);
+        pendingDone.wait(l, [&]() { return pending == 0; });
+    }
+    if (!_throwInvalid)
+        return;
+    for (auto const& transaction : _transactions)
+        transaction.sender();
+}
+
 SignatureStruct const& Transaction::signature() const
 {
     if (!m_vrs)
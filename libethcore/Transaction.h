@@ -276,6 +276,11 @@ protected:
 /// Nice name for vector of Transaction.
 using Transactions = std::vector<Transaction>;
 
+/// Recover the senders of _transactions concurrently and cache them in the transactions.
+/// @throws the exception of sender() for the first transaction whose sender can't be recovered,
+/// unless _throwInvalid is false, which leaves the invalid transactions to the caller
+void recoverSenders(Transactions const& _transactions, bool _throwInvalid = true);
+
 /// Simple human-readable stream-shift operator.
 inline std::ostream& operator<<(std::ostream& _out, Transaction const& _t)
 {
@@ -136,6 +136,7 @@ bool Executive::call(CallParameters const& _p, u256 const& _gasPrice, Address co
     m_savepoint = m_s->savepoint();
     m_memoryTableFactorySavePoint =
         m_envInfo.precompiledEngine()->getMemoryTableFactory()->savepoint();
+    bool isPrecompiled = false;
     if (m_envInfo.precompiledEngine() &&
         m_envInfo.precompiledEngine()->isOrginPrecompiled(_p.codeAddress))
     {
@@ -151,6 +152,7 @@ bool Executive::call(CallParameters const& _p, u256 const& _gasPrice, Address co
              m_envInfo.precompiledEngine()->isPrecompiled(_p.codeAddress))
     {
         m_gas = _p.gas;
+        isPrecompiled = true;
 
         LOG(DEBUG) << "Execute Precompiled: " << _p.codeAddress;
 
@@ -171,8 +173,11 @@ bool Executive::call(CallParameters const& _p, u256 const& _gasPrice, Address co
         }
     }
 
-    // Transfer ether.
-    m_s->transferBalance(_p.senderAddress, _p.receiveAddress, _p.valueTransfer);
+    // Transfer ether. Precompiled contracts have no account to touch without a value on the chains
+    // of version 1, so the calls only access the keys they declare
+    if (!isPrecompiled || _p.valueTransfer > 0 ||
+        m_envInfo.precompiledEngine()->chainVersion() == 0)
+        m_s->transferBalance(_p.senderAddress, _p.receiveAddress, _p.valueTransfer);
     return !m_ext;
 }
 
@@ -0,0 +1,163 @@
+/*
+    This file is part of FISCO-BCOS.
+
+    FISCO-BCOS is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FISCO-BCOS is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file AnalysisCache.h
+ * @record cache of the code analysis done by VM::optimize
+ */
+
+#pragma once
+
+#include <libdevcore/Common.h>
+#include <libdevcore/FixedHash.h>
+#include <libdevcore/Guards.h>
+#include <list>
+#include <map>
+#include <memory>
+
+namespace dev
+{
+namespace eth
+{
+/// A straight-line run of fixed-cost instructions, whose gas and stack bounds are checked once
+/// when it is entered. It starts at a JUMPDEST or after an instruction which isn't in a block, and
+/// ends with a jump, STOP or before such an instruction.
+struct BasicBlock
+{
+    uint64_t gas = 0;       ///< the sum of the gas of the instructions
+    uint32_t ops = 0;       ///< the number of instructions
+    int32_t minStack = 0;   ///< the stack items needed by the instructions
+    int32_t maxGrowth = 0;  ///< the largest growth of the stack within the block
+};
+
+/// The result of VM::optimize for one contract code, shared by all VMs executing the code.
+struct AnalyzedCode
+{
+    typedef std::shared_ptr<AnalyzedCode const> Ptr;
+
+    bytes code;                   ///< padded code with synthetic opcodes invalidated
+    std::vector<bool> jumpDests;  ///< bitmap of the JUMPDEST positions
+    std::vector<u256> pool;       ///< constant pool of the first pass optimization
+    std::vector<BasicBlock> blocks;
+    /// 1 + the index in blocks of the block starting at each position, 0 if none starts there
+    std::vector<uint32_t> blockIndex;
+
+    size_t memorySize() const
+    {
+        return sizeof(AnalyzedCode) + code.size() + jumpDests.size() / 8 +
+               pool.size() * sizeof(u256) + blocks.size() * sizeof(BasicBlock) +
+               blockIndex.size() * sizeof(uint32_t);
+    }
+};
+
+/**
+ * @brief Thread-safe cache from code hash to the analyzed code, shared by all VMs.
+ * The VMs execute the cached code in place, and the least recently used code is removed when
+ * the cache holds more than its memory limit.
+ */
+class AnalysisCache
+{
+public:
+    explicit AnalysisCache(size_t _maxMemory = c_defaultMaxMemory) : m_maxMemory(_maxMemory) {}
+
+    /// @returns nullptr if the code hasn't been analyzed yet
+    AnalyzedCode::Ptr get(h256 const& _hash, size_t _codeSize)
+    {
+        Guard g(x_cache);
+        auto it = m_cache.find(_hash);
+        if (it == m_cache.end() || it->second->codeSize != _codeSize)
+        {
+            ++m_misses;
+            return nullptr;
+        }
+        m_lru.splice(m_lru.begin(), m_lru, it->second);
+        ++m_hits;
+        return it->second->analyzed;
+    }
+
+    void store(h256 const& _hash, size_t _codeSize, AnalyzedCode::Ptr _analyzed)
+    {
+        size_t memory = _analyzed->memorySize();
+        if (memory > m_maxMemory)
+            return;
+        Guard g(x_cache);
+        auto it = m_cache.find(_hash);
+        if (it != m_cache.end())
+            remove(it->second);
+        m_lru.push_front(CacheItem{_hash, _codeSize, memory, _analyzed});
+        m_cache[_hash] = m_lru.begin();
+        m_memory += memory;
+        while (m_memory > m_maxMemory)
+            remove(std::prev(m_lru.end()));
+    }
+
+    size_t size() const
+    {
+        Guard g(x_cache);
+        return m_cache.size();
+    }
+    size_t memory() const
+    {
+        Guard g(x_cache);
+        return m_memory;
+    }
+    uint64_t hits() const
+    {
+        Guard g(x_cache);
+        return m_hits;
+    }
+    uint64_t misses() const
+    {
+        Guard g(x_cache);
+        return m_misses;
+    }
+
+    static AnalysisCache& instance()
+    {
+        static AnalysisCache cache;
+        return cache;
+    }
+
+private:
+    struct CacheItem
+    {
+        h256 hash;
+        size_t codeSize;
+        size_t memory;
+        AnalyzedCode::Ptr analyzed;
+    };
+    typedef std::list<CacheItem>::iterator ItemIterator;
+
+    void remove(ItemIterator _item)
+    {
+        m_memory -= _item->memory;
+        m_cache.erase(_item->hash);
+        m_lru.erase(_item);
+    }
+
+    /// the analysis of a few thousand contracts of the maximum code size
+    static const size_t c_defaultMaxMemory = 64 * 1024 * 1024;
+    size_t m_maxMemory;
+    mutable Mutex x_cache;
+    /// the most recently used code first
+    std::list<CacheItem> m_lru;
+    std::map<h256, ItemIterator> m_cache;
+    size_t m_memory = 0;
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+};
+
+}  // namespace eth
+}  // namespace dev
@@ -0,0 +1,156 @@
+/*
+    This file is part of FISCO-BCOS.
+
+    FISCO-BCOS is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FISCO-BCOS is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file Arith256.h
+ * @record 4x64-bit kernels of the hot 256-bit opcodes of the interpreter
+ */
+
+#pragma once
+
+#include <libdevcore/Common.h>
+#include <limits>
+
+// The kernels work on the four 64-bit limbs of the u256 stack items where the generic
+// boost::multiprecision operators are slow: decoding the PUSH data byte by byte, the truncated
+// multiplication, the signed comparisons through s256 and the 512-bit division.
+// ADD, SUB and the unsigned comparisons are as fast with the fixed-width boost backend.
+#if defined(__SIZEOF_INT128__)
+#define EVM_USE_ARITH256_KERNELS true
+#else
+#define EVM_USE_ARITH256_KERNELS false
+#endif
+
+namespace dev
+{
+namespace eth
+{
+namespace arith256
+{
+#if EVM_USE_ARITH256_KERNELS
+
+static_assert(sizeof(boost::multiprecision::limb_type) == sizeof(uint64_t),
+    "the kernels need the 64-bit limbs of the 128-bit capable platforms");
+
+typedef unsigned __int128 uint128;
+
+/// the limbs of _x, least significant first
+inline void load(u256 const& _x, uint64_t* o_words)
+{
+    auto const& backend = _x.backend();
+    unsigned const size = backend.size();
+    auto const* limbs = backend.limbs();
+    for (unsigned i = 0; i < 4; ++i)
+        o_words[i] = i < size ? limbs[i] : 0;
+}
+
+inline void store(uint64_t const* _words, u256& o_x)
+{
+    auto& backend = o_x.backend();
+    backend.resize(4, 4);
+    auto* limbs = backend.limbs();
+    for (unsigned i = 0; i < 4; ++i)
+        limbs[i] = _words[i];
+    backend.normalize();
+}
+
+/// _a * _b mod 2^256, the products above 2^256 are never computed
+inline void mul(u256 const& _a, u256 const& _b, u256& o_r)
+{
+    uint64_t a[4], b[4], r[4] = {0, 0, 0, 0};
+    load(_a, a);
+    load(_b, b);
+    for (unsigned i = 0; i < 4; ++i)
+    {
+        if (!a[i])
+            continue;
+        uint64_t carry = 0;
+        for (unsigned j = 0; i + j < 4; ++j)
+        {
+            uint128 product = uint128(a[i]) * b[j] + r[i + j] + carry;
+            r[i + j] = uint64_t(product);
+            carry = uint64_t(product >> 64);
+        }
+    }
+    store(r, o_r);
+}
+
+/// _a < _b as two's complement numbers
+inline bool slt(u256 const& _a, u256 const& _b)
+{
+    bool const negativeA = _a.backend().size() == 4 && (_a.backend().limbs()[3] >> 63);
+    bool const negativeB = _b.backend().size() == 4 && (_b.backend().limbs()[3] >> 63);
+    if (negativeA != negativeB)
+        return negativeA;
+    return _a < _b;
+}
+
+/// the operands of DIV and MOD mostly fit in 64 bits
+inline bool fitsInWord(u256 const& _x)
+{
+    return _x.backend().size() == 1;
+}
+
+inline uint64_t word(u256 const& _x)
+{
+    return _x.backend().limbs()[0];
+}
+
+/// the _size bytes of a PUSH, most significant first
+inline void loadBigEndian(byte const* _data, unsigned _size, u256& o_r)
+{
+    uint64_t r[4] = {0, 0, 0, 0};
+    for (unsigned i = 0; i < _size; ++i)
+    {
+        unsigned const shift = _size - 1 - i;
+        r[shift / 8] |= uint64_t(_data[i]) << (shift % 8 * 8);
+    }
+    store(r, o_r);
+}
+
+#else
+
+inline void mul(u256 const& _a, u256 const& _b, u256& o_r)
+{
+    o_r = _a * _b;
+}
+
+inline bool slt(u256 const& _a, u256 const& _b)
+{
+    return u2s(_a) < u2s(_b);
+}
+
+inline bool fitsInWord(u256 const& _x)
+{
+    return _x <= std::numeric_limits<uint64_t>::max();
+}
+
+inline uint64_t word(u256 const& _x)
+{
+    return uint64_t(_x);
+}
+
+inline void loadBigEndian(byte const* _data, unsigned _size, u256& o_r)
+{
+    o_r = 0;
+    for (unsigned i = 0; i < _size; ++i)
+        o_r = (o_r << 8) | _data[i];
+}
+
+#endif
+
+}  // namespace arith256
+}  // namespace eth
+}  // namespace dev
@@ -20,6 +20,7 @@
  * @record copy from aleth, this is a default VM
  */
 
+#include "Arith256.h"
 #include "VM.h"
 #include "interpreter.h"
 
@@ -39,11 +40,48 @@ void delete_output(const evmc_result* result)
     delete[] result->output_data;
 }
 
+/**
+ * @brief The VMs of the finished calls of a thread, reused by its next calls so that their 32KB
+ * stack and their memory aren't allocated and zero-filled again for each call frame. A nested
+ * call takes another VM from the pool while its caller is running.
+ */
+class VMPool
+{
+public:
+    std::unique_ptr<dev::eth::VM> acquire()
+    {
+        if (m_vms.empty())
+            return std::unique_ptr<dev::eth::VM>(new dev::eth::VM);
+        auto vm = std::move(m_vms.back());
+        m_vms.pop_back();
+        return vm;
+    }
+
+    void release(std::unique_ptr<dev::eth::VM> _vm, dev::bytes&& _memory)
+    {
+        // the VMs of the deeper calls are freed
+        if (m_vms.size() >= c_maxVMs)
+            return;
+        _vm->reset(std::move(_memory));
+        m_vms.push_back(std::move(_vm));
+    }
+
+    static VMPool& instance()
+    {
+        static thread_local VMPool pool;
+        return pool;
+    }
+
+private:
+    static const size_t c_maxVMs = 64;
+    std::vector<std::unique_ptr<dev::eth::VM>> m_vms;
+};
+
 evmc_result execute(evmc_instance* _instance, evmc_context* _context, evmc_revision _rev,
     const evmc_message* _msg, uint8_t const* _code, size_t _codeSize) noexcept
 {
     (void)_instance;
-    std::unique_ptr<dev::eth::VM> vm{new dev::eth::VM};
+    auto vm = VMPool::instance().acquire();
 
     evmc_result result = {};
     dev::owning_bytes_ref output;
@@ -106,6 +144,8 @@ evmc_result execute(evmc_instance* _instance, evmc_context* _context, evmc_revis
         result.output_size = output.size();
         result.release = delete_output;
     }
+    // RETURN and REVERT give the memory of the VM away with the output
+    VMPool::instance().release(std::move(vm), output.takeBytes());
 
     return result;
 }
@@ -234,14 +274,41 @@ void VM::logGasMem()
     updateMem(memNeed(m_SP[0], m_SP[1]));
 }
 
+bool VM::enterBlock()
+{
+    auto const& blockIndex = m_analyzed->blockIndex;
+    if (m_PC >= blockIndex.size() || !blockIndex[m_PC])
+        return false;
+    auto const& block = m_analyzed->blocks[blockIndex[m_PC] - 1];
+    // otherwise the instructions are checked one by one to fail at the same one
+    size_t const stack = m_stackEnd - m_SPP;
+    if (m_io_gas < block.gas || stack < size_t(block.minStack) ||
+        stack + block.maxGrowth > size_t(VMSchedule::stackLimit))
+        return false;
+    m_io_gas -= block.gas;
+    m_blockOps = block.ops;
+    return true;
+}
+
 void VM::fetchInstruction()
 {
     m_OP = Instruction(m_code[m_PC]);
     auto const metric = c_metrics[static_cast<size_t>(m_OP)];
-    adjustStack(metric.num_stack_arguments, metric.num_stack_returned_items);
+    if (m_blockOps || enterBlock())
+    {
+        // the gas and the stack bounds were checked on entry of the block
+        --m_blockOps;
+        m_SP = m_SPP;
+        m_SPP += metric.num_stack_arguments - metric.num_stack_returned_items;
+        m_runGas = 0;
+    }
+    else
+    {
+        adjustStack(metric.num_stack_arguments, metric.num_stack_returned_items);
 
-    // FEES...
-    m_runGas = metric.gas_cost;
+        // FEES...
+        m_runGas = metric.gas_cost;
+    }
     m_newMemSize = m_mem.size();
     m_copyMemSize = 0;
 }
@@ -269,6 +336,7 @@ owning_bytes_ref VM::exec(evmc_context* _context, evmc_revision _rev, const evmc
     m_message = _msg;
     m_io_gas = uint64_t(_msg->gas);
     m_PC = 0;
+    m_blockOps = 0;
     m_pCode = _code;
     m_codeSize = _codeSize;
 
@@ -281,9 +349,54 @@ owning_bytes_ref VM::exec(evmc_context* _context, evmc_revision _rev, const evmc
     return std::move(m_output);
 }
 
+void VM::reset(bytes&& _memory)
+{
+    if (_memory.capacity() > m_mem.capacity())
+        m_mem = std::move(_memory);
+    // the memory of the next call is zero-filled as it grows, like a new one
+    if (m_mem.capacity() > c_maxReusedMemory)
+        bytes().swap(m_mem);
+    else
+        m_mem.clear();
+    m_returnData.clear();
+    m_output = owning_bytes_ref();
+    m_tx_context = boost::none;
+    m_analyzed.reset();
+    m_code = nullptr;
+    m_pool = nullptr;
+    // the stack items are always written before they are read
+    m_SP = m_SPP = m_stackEnd;
+    m_nSteps = 0;
+    m_blockOps = 0;
+    m_runGas = 0;
+    m_newMemSize = 0;
+    m_copyMemSize = 0;
+    m_io_gas = 0;
+}
+
+VM::MemFnPtr VM::interpreter(evmc_revision _rev)
+{
+    switch (_rev)
+    {
+    case EVMC_FRONTIER:
+        return &VM::interpretCases<EVMC_FRONTIER>;
+    case EVMC_HOMESTEAD:
+        return &VM::interpretCases<EVMC_HOMESTEAD>;
+    case EVMC_TANGERINE_WHISTLE:
+        return &VM::interpretCases<EVMC_TANGERINE_WHISTLE>;
+    case EVMC_SPURIOUS_DRAGON:
+        return &VM::interpretCases<EVMC_SPURIOUS_DRAGON>;
+    case EVMC_BYZANTIUM:
+        return &VM::interpretCases<EVMC_BYZANTIUM>;
+    default:
+        return &VM::interpretCases<EVMC_CONSTANTINOPLE>;
+    }
+}
+
 //
-// main interpreter loop and switch
+// main interpreter loop and switch, the revision checks are folded at compile time
 //
+template <evmc_revision Rev>
 void VM::interpretCases()
 {
     INIT_CASES
@@ -296,7 +409,7 @@ void VM::interpretCases()
         CASE(CREATE2)
         {
             ON_OP();
-            if (m_rev < EVMC_CONSTANTINOPLE)
+            if (Rev < EVMC_CONSTANTINOPLE)
                 throwBadInstruction();
             if (m_message->flags & EVMC_STATIC)
                 throwDisallowedStateChange();
@@ -321,9 +434,9 @@ void VM::interpretCases()
         CASE(CALLCODE)
         {
             ON_OP();
-            if (m_OP == Instruction::DELEGATECALL && m_rev < EVMC_HOMESTEAD)
+            if (m_OP == Instruction::DELEGATECALL && Rev < EVMC_HOMESTEAD)
                 throwBadInstruction();
-            if (m_OP == Instruction::STATICCALL && m_rev < EVMC_BYZANTIUM)
+            if (m_OP == Instruction::STATICCALL && Rev < EVMC_BYZANTIUM)
                 throwBadInstruction();
             if (m_OP == Instruction::CALL && m_message->flags & EVMC_STATIC && m_SP[2] != 0)
                 throwDisallowedStateChange();
@@ -348,7 +461,7 @@ void VM::interpretCases()
         CASE(REVERT)
         {
             // Pre-byzantium
-            if (m_rev < EVMC_BYZANTIUM)
+            if (Rev < EVMC_BYZANTIUM)
                 throwBadInstruction();
 
             ON_OP();
@@ -369,20 +482,20 @@ void VM::interpretCases()
             if (m_message->flags & EVMC_STATIC)
                 throwDisallowedStateChange();
 
-            m_runGas = m_rev >= EVMC_TANGERINE_WHISTLE ? 5000 : 0;
+            m_runGas = Rev >= EVMC_TANGERINE_WHISTLE ? 5000 : 0;
             evmc_address destination = toEvmC(asAddress(m_SP[0]));
 
             // After EIP158 zero-value suicides do not have to pay account creation gas.
             evmc_uint256be rawBalance;
             m_context->fn_table->get_balance(&rawBalance, m_context, &m_message->destination);
             u256 balance = fromEvmC(rawBalance);
-            if (balance > 0 || m_rev < EVMC_SPURIOUS_DRAGON)
+            if (balance > 0 || Rev < EVMC_SPURIOUS_DRAGON)
             {
                 // After EIP150 hard fork charge additional cost of sending
                 // ethers to non-existing account.
                 int destinationExists =
                     m_context->fn_table->account_exists(m_context, &destination);
-                if (m_rev >= EVMC_TANGERINE_WHISTLE && !destinationExists)
+                if (Rev >= EVMC_TANGERINE_WHISTLE && !destinationExists)
                     m_runGas += VMSchedule::callNewAccount;
             }
 
@@ -551,7 +664,7 @@ void VM::interpretCases()
             CASE(EXP)
         {
             u256 expon = m_SP[1];
-            const int64_t byteCost = m_rev >= EVMC_SPURIOUS_DRAGON ? 50 : 10;
+            const int64_t byteCost = Rev >= EVMC_SPURIOUS_DRAGON ? 50 : 10;
             m_runGas =
                 toInt63(VMSchedule::stepGas5 + byteCost * (32 - (h256(expon).firstBitSet() / 8)));
             ON_OP();
@@ -582,7 +695,7 @@ void VM::interpretCases()
             updateIOGas();
 
             // pops two items and pushes their product mod 2^256.
-            m_SPP[0] = m_SP[0] * m_SP[1];
+            arith256::mul(m_SP[0], m_SP[1], m_SPP[0]);
         }
         NEXT
 
@@ -600,7 +713,12 @@ void VM::interpretCases()
             ON_OP();
             updateIOGas();
 
-            m_SPP[0] = m_SP[1] ? divWorkaround(m_SP[0], m_SP[1]) : 0;
+            if (!m_SP[1])
+                m_SPP[0] = 0;
+            else if (arith256::fitsInWord(m_SP[0]) && arith256::fitsInWord(m_SP[1]))
+                m_SPP[0] = arith256::word(m_SP[0]) / arith256::word(m_SP[1]);
+            else
+                m_SPP[0] = divWorkaround(m_SP[0], m_SP[1]);
         }
         NEXT
 
@@ -619,7 +737,12 @@ void VM::interpretCases()
             ON_OP();
             updateIOGas();
 
-            m_SPP[0] = m_SP[1] ? modWorkaround(m_SP[0], m_SP[1]) : 0;
+            if (!m_SP[1])
+                m_SPP[0] = 0;
+            else if (arith256::fitsInWord(m_SP[0]) && arith256::fitsInWord(m_SP[1]))
+                m_SPP[0] = arith256::word(m_SP[0]) % arith256::word(m_SP[1]);
+            else
+                m_SPP[0] = modWorkaround(m_SP[0], m_SP[1]);
         }
         NEXT
 
@@ -664,7 +787,7 @@ void VM::interpretCases()
             ON_OP();
             updateIOGas();
 
-            m_SPP[0] = u2s(m_SP[0]) < u2s(m_SP[1]) ? 1 : 0;
+            m_SPP[0] = arith256::slt(m_SP[0], m_SP[1]) ? 1 : 0;
         }
         NEXT
 
@@ -673,7 +796,7 @@ void VM::interpretCases()
             ON_OP();
             updateIOGas();
 
-            m_SPP[0] = u2s(m_SP[0]) > u2s(m_SP[1]) ? 1 : 0;
+            m_SPP[0] = arith256::slt(m_SP[1], m_SP[0]) ? 1 : 0;
         }
         NEXT
 
@@ -734,7 +857,7 @@ void VM::interpretCases()
             CASE(SHL)
         {
             // Pre-constantinople
-            if (m_rev < EVMC_CONSTANTINOPLE)
+            if (Rev < EVMC_CONSTANTINOPLE)
                 throwBadInstruction();
 
             ON_OP();
@@ -750,7 +873,7 @@ void VM::interpretCases()
             CASE(SHR)
         {
             // Pre-constantinople
-            if (m_rev < EVMC_CONSTANTINOPLE)
+            if (Rev < EVMC_CONSTANTINOPLE)
                 throwBadInstruction();
 
             ON_OP();
@@ -766,7 +889,7 @@ void VM::interpretCases()
             CASE(SAR)
         {
             // Pre-constantinople
-            if (m_rev < EVMC_CONSTANTINOPLE)
+            if (Rev < EVMC_CONSTANTINOPLE)
                 throwBadInstruction();
 
             ON_OP();
@@ -892,7 +1015,7 @@ void VM::interpretCases()
 
             CASE(BALANCE)
         {
-            m_runGas = m_rev >= EVMC_TANGERINE_WHISTLE ? 400 : 20;
+            m_runGas = Rev >= EVMC_TANGERINE_WHISTLE ? 400 : 20;
             ON_OP();
             updateIOGas();
 
@@ -958,7 +1081,7 @@ void VM::interpretCases()
 
             CASE(RETURNDATASIZE)
         {
-            if (m_rev < EVMC_BYZANTIUM)
+            if (Rev < EVMC_BYZANTIUM)
                 throwBadInstruction();
 
             ON_OP();
@@ -979,7 +1102,7 @@ void VM::interpretCases()
 
             CASE(EXTCODESIZE)
         {
-            m_runGas = m_rev >= EVMC_TANGERINE_WHISTLE ? 700 : 20;
+            m_runGas = Rev >= EVMC_TANGERINE_WHISTLE ? 700 : 20;
             ON_OP();
             updateIOGas();
 
@@ -1004,7 +1127,7 @@ void VM::interpretCases()
             CASE(RETURNDATACOPY)
         {
             ON_OP();
-            if (m_rev < EVMC_BYZANTIUM)
+            if (Rev < EVMC_BYZANTIUM)
                 throwBadInstruction();
             bigint const endOfAccess = bigint(m_SP[1]) + bigint(m_SP[2]);
             if (m_returnData.size() < endOfAccess)
@@ -1021,7 +1144,7 @@ void VM::interpretCases()
             CASE(EXTCODEHASH)
         {
             ON_OP();
-            if (m_rev < EVMC_CONSTANTINOPLE)
+            if (Rev < EVMC_CONSTANTINOPLE)
                 throwBadInstruction();
 
             updateIOGas();
@@ -1048,7 +1171,7 @@ void VM::interpretCases()
             CASE(EXTCODECOPY)
         {
             ON_OP();
-            m_runGas = m_rev >= EVMC_TANGERINE_WHISTLE ? 700 : 20;
+            m_runGas = Rev >= EVMC_TANGERINE_WHISTLE ? 700 : 20;
             uint64_t copyMemSize = toInt63(m_SP[3]);
             m_copyMemSize = copyMemSize;
             updateMem(memNeed(m_SP[1], m_SP[3]));
@@ -1220,12 +1343,11 @@ void VM::interpretCases()
             updateIOGas();
 
             int numBytes = (int)m_OP - (int)Instruction::PUSH1 + 1;
-            m_SPP[0] = 0;
             // Construct a number out of PUSH bytes.
             // This requires the code has been copied and extended by 32 zero
             // bytes to handle "out of code" push data here.
-            for (++m_PC; numBytes--; ++m_PC)
-                m_SPP[0] = (m_SPP[0] << 8) | m_code[m_PC];
+            arith256::loadBigEndian(&m_code[++m_PC], numBytes, m_SPP[0]);
+            m_PC += numBytes;
         }
         CONTINUE
 
@@ -1322,7 +1444,7 @@ void VM::interpretCases()
 
             CASE(SLOAD)
         {
-            m_runGas = m_rev >= EVMC_TANGERINE_WHISTLE ? 200 : 50;
+            m_runGas = Rev >= EVMC_TANGERINE_WHISTLE ? 200 : 50;
             ON_OP();
             updateIOGas();
 
@@ -1387,7 +1509,7 @@ void VM::interpretCases()
 
             CASE(JUMPDEST)
         {
-            m_runGas = VMSchedule::jumpdestGas;
+            // the gas is VMSchedule::jumpdestGas in the metrics, charged with the basic block
             ON_OP();
             updateIOGas();
         }
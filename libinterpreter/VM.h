@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include "AnalysisCache.h"
 #include "VMConfig.h"
 
 #include <libdevcore/Common.h>
@@ -73,6 +74,10 @@ public:
     owning_bytes_ref exec(evmc_context* _context, evmc_revision _rev, const evmc_message* _msg,
         uint8_t const* _code, size_t _codeSize);
 
+    /// prepares the VM for the next call, keeping the buffers of its stack and memory
+    /// @param _memory the memory given away with the output of the call, if any
+    void reset(bytes&& _memory);
+
     uint64_t m_io_gas = 0;
 
 private:
@@ -84,7 +89,6 @@ private:
     static std::array<evmc_instruction_metrics, 256> c_metrics;
     static void initMetrics();
     static u256 exp256(u256 _base, u256 _exponent);
-    void copyCode(int);
     typedef void (VM::*MemFnPtr)();
     MemFnPtr m_bounce = nullptr;
     uint64_t m_nSteps = 0;
@@ -94,11 +98,14 @@ private:
 
     // space for memory
     bytes m_mem;
+    /// larger memory isn't kept by reset, to not hold it in the idle VMs
+    static const size_t c_maxReusedMemory = 1024 * 1024;
 
     uint8_t const* m_pCode = nullptr;
     size_t m_codeSize = 0;
-    // space for code
-    bytes m_code;
+    // the analyzed code executed in place, shared with the other VMs through the AnalysisCache
+    AnalyzedCode::Ptr m_analyzed;
+    byte const* m_code = nullptr;
 
     /// RETURNDATA buffer for memory returned from direct subcalls.
     bytes m_returnData;
@@ -109,7 +116,7 @@ private:
     size_t stackSize() { return m_stackEnd - m_SP; }
 
     // constant pool
-    std::vector<u256> m_pool;
+    u256 const* m_pool = nullptr;
 
     // interpreter state
     Instruction m_OP;         // current operation
@@ -125,9 +132,15 @@ private:
     // initialize interpreter
     void initEntry();
     void optimize();
+    void analyze(AnalyzedCode& o_analyzed);
 
     // interpreter loop & switch
+    template <evmc_revision Rev>
     void interpretCases();
+    /// @returns interpretCases instantiated for the revision
+    static MemFnPtr interpreter(evmc_revision _rev);
+    /// chosen once per call by initEntry, and resumed after the instructions that call out
+    MemFnPtr m_interpret = nullptr;
 
     // interpreter cases that call out
     void caseCreate();
@@ -148,7 +161,6 @@ private:
     void throwBufferOverrun(bigint const& _enfOfAccess);
 
     std::vector<uint64_t> m_beginSubs;
-    std::vector<uint64_t> m_jumpDests;
     int64_t verifyJumpDest(u256 const& _dest, bool _throw = true);
 
     void onOperation() {}
@@ -159,6 +171,10 @@ private:
     void updateMem(uint64_t _newMem);
     void logGasMem();
     void fetchInstruction();
+    /// checks and charges the basic block starting at m_PC, @returns false if there is none
+    bool enterBlock();
+    /// the instructions left in the basic block being run
+    uint32_t m_blockOps = 0;
 
     uint64_t decodeJumpDest(const byte* const _code, uint64_t& _pc);
     uint64_t decodeJumpvDest(const byte* const _code, uint64_t& _pc, byte _voff);
@@ -96,9 +96,9 @@ int64_t VM::verifyJumpDest(u256 const& _dest, bool _throw)
     if (_dest <= 0x7FFFFFFFFFFFFFFF)
     {
         // check for within bounds and to a jump destination
-        // use binary search of array because hashtable collisions are exploitable
         uint64_t pc = uint64_t(_dest);
-        if (std::binary_search(m_jumpDests.begin(), m_jumpDests.end(), pc))
+        auto const& jumpDests = m_analyzed->jumpDests;
+        if (pc < jumpDests.size() && jumpDests[pc])
             return pc;
     }
     if (_throw)
@@ -113,7 +113,7 @@ int64_t VM::verifyJumpDest(u256 const& _dest, bool _throw)
 
 void VM::caseCreate()
 {
-    m_bounce = &VM::interpretCases;
+    m_bounce = m_interpret;
     m_runGas = VMSchedule::createGas;
 
     // Collect arguments.
@@ -176,7 +176,7 @@ void VM::caseCreate()
 
 void VM::caseCall()
 {
-    m_bounce = &VM::interpretCases;
+    m_bounce = m_interpret;
 
     evmc_message msg = {};
 
@@ -20,6 +20,8 @@
  * @record copy from aleth, this is a default VM
  */
 
+#include "AnalysisCache.h"
+#include "Arith256.h"
 #include "VM.h"
 
 namespace dev
@@ -45,41 +47,157 @@ void VM::initMetrics()
     (void)done;
 }
 
-void VM::copyCode(int _extraBytes)
+namespace
 {
-    // Copy code so that it can be safely modified and extend code by
-    // _extraBytes zero bytes to allow reading virtual data at the end
-    // of the code without bounds checks.
-    auto extendedSize = m_codeSize + _extraBytes;
-    m_code.reserve(extendedSize);
-    m_code.assign(m_pCode, m_pCode + m_codeSize);
-    m_code.resize(extendedSize);
+/// Instructions of a fixed gas cost, which only throw for their stack or gas, so that they can be
+/// checked and charged once per basic block with the same result as one by one. Their cost must
+/// not depend on the revision.
+bool isBlockInstruction(Instruction _op)
+{
+    if ((byte)Instruction::PUSH1 <= (byte)_op && (byte)_op <= (byte)Instruction::PUSH32)
+        return true;
+    if ((byte)Instruction::DUP1 <= (byte)_op && (byte)_op <= (byte)Instruction::DUP16)
+        return true;
+    if ((byte)Instruction::SWAP1 <= (byte)_op && (byte)_op <= (byte)Instruction::SWAP16)
+        return true;
+    switch (_op)
+    {
+    case Instruction::STOP:
+    case Instruction::ADD:
+    case Instruction::MUL:
+    case Instruction::SUB:
+    case Instruction::DIV:
+    case Instruction::SDIV:
+    case Instruction::MOD:
+    case Instruction::SMOD:
+    case Instruction::ADDMOD:
+    case Instruction::MULMOD:
+    case Instruction::SIGNEXTEND:
+    case Instruction::LT:
+    case Instruction::GT:
+    case Instruction::SLT:
+    case Instruction::SGT:
+    case Instruction::EQ:
+    case Instruction::ISZERO:
+    case Instruction::AND:
+    case Instruction::OR:
+    case Instruction::XOR:
+    case Instruction::NOT:
+    case Instruction::BYTE:
+    case Instruction::ADDRESS:
+    case Instruction::ORIGIN:
+    case Instruction::CALLER:
+    case Instruction::CALLVALUE:
+    case Instruction::CALLDATALOAD:
+    case Instruction::CALLDATASIZE:
+    case Instruction::CODESIZE:
+    case Instruction::GASPRICE:
+    case Instruction::COINBASE:
+    case Instruction::TIMESTAMP:
+    case Instruction::NUMBER:
+    case Instruction::DIFFICULTY:
+    case Instruction::GASLIMIT:
+    case Instruction::POP:
+    case Instruction::JUMP:
+    case Instruction::JUMPI:
+    case Instruction::PC:
+    case Instruction::MSIZE:
+    case Instruction::JUMPDEST:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/// the instructions after them are only reached by a jump or the fall through of JUMPI
+bool endsBlock(Instruction _op)
+{
+    return _op == Instruction::JUMP || _op == Instruction::JUMPI || _op == Instruction::STOP;
 }
+}  // namespace
 
 void VM::optimize()
 {
-    copyCode(33);
+    // the analysis only depends on the code, so reuse it across calls of the same contract
+    h256 codeHash(m_message->code_hash.bytes, h256::ConstructFromPointer);
+    AnalyzedCode::Ptr analyzed;
+    if (codeHash)
+        analyzed = AnalysisCache::instance().get(codeHash, m_codeSize);
+    if (!analyzed)
+    {
+        auto code = std::make_shared<AnalyzedCode>();
+        // verifyJumpDest reads the jump destinations while the code is analyzed
+        m_analyzed = code;
+        analyze(*code);
+        analyzed = code;
+        if (codeHash)
+            AnalysisCache::instance().store(codeHash, m_codeSize, analyzed);
+    }
+
+    // the analyzed code is never modified, so it is executed in place
+    m_analyzed = analyzed;
+    m_code = analyzed->code.data();
+    m_pool = analyzed->pool.data();
+}
 
+void VM::analyze(AnalyzedCode& o_analyzed)
+{
     size_t const nBytes = m_codeSize;
 
-    // build a table of jump destinations for use in verifyJumpDest
+    // Copy code so that it can be safely modified and extend code by
+    // 33 zero bytes to allow reading virtual data at the end
+    // of the code without bounds checks.
+    bytes& code = o_analyzed.code;
+    code.reserve(nBytes + 33);
+    code.assign(m_pCode, m_pCode + nBytes);
+    code.resize(nBytes + 33);
+    o_analyzed.jumpDests.resize(nBytes);
+    o_analyzed.blockIndex.resize(nBytes);
+
+    // build a table of jump destinations for use in verifyJumpDest,
+    // and the basic blocks checked once by fetchInstruction
 
     TRACE_STR(1, "Build JUMPDEST table")
+    BasicBlock* block = nullptr;
+    int32_t stack = 0;
     for (size_t pc = 0; pc < nBytes; ++pc)
     {
-        Instruction op = Instruction(m_code[pc]);
+        Instruction op = Instruction(code[pc]);
         TRACE_OP(2, pc, op);
 
         // make synthetic ops in user code trigger invalid instruction if run
         if (op == Instruction::PUSHC || op == Instruction::JUMPC || op == Instruction::JUMPCI)
         {
             TRACE_OP(1, pc, op);
-            m_code[pc] = (byte)Instruction::INVALID;
+            code[pc] = (byte)Instruction::INVALID;
+            op = Instruction::INVALID;
+        }
+
+        // the first pass optimization keeps the metrics, PUSHC and JUMPC copy PUSH1 and JUMP
+        if (op == Instruction::JUMPDEST || !isBlockInstruction(op))
+            block = nullptr;
+        if (isBlockInstruction(op))
+        {
+            if (!block)
+            {
+                o_analyzed.blocks.push_back(BasicBlock());
+                o_analyzed.blockIndex[pc] = o_analyzed.blocks.size();
+                block = &o_analyzed.blocks.back();
+                stack = 0;
+            }
+            auto const& metric = c_metrics[static_cast<size_t>(op)];
+            block->gas += metric.gas_cost;
+            ++block->ops;
+            block->minStack = std::max(block->minStack, metric.num_stack_arguments - stack);
+            stack += metric.num_stack_returned_items - metric.num_stack_arguments;
+            block->maxGrowth = std::max(block->maxGrowth, stack);
+            if (endsBlock(op))
+                block = nullptr;
         }
 
         if (op == Instruction::JUMPDEST)
         {
-            m_jumpDests.push_back(pc);
+            o_analyzed.jumpDests[pc] = true;
         }
         else if ((byte)Instruction::PUSH1 <= (byte)op && (byte)op <= (byte)Instruction::PUSH32)
         {
@@ -93,17 +211,17 @@ void VM::optimize()
     for (size_t pc = 0; pc < nBytes; ++pc)
     {
         u256 val = 0;
-        Instruction op = Instruction(m_code[pc]);
+        Instruction op = Instruction(code[pc]);
 
         if ((byte)Instruction::PUSH1 <= (byte)op && (byte)op <= (byte)Instruction::PUSH32)
         {
             byte nPush = (byte)op - (byte)Instruction::PUSH1 + 1;
 
             // decode pushed bytes to integral value
-            val = m_code[pc + 1];
+            val = code[pc + 1];
             for (uint64_t i = pc + 2, n = nPush; --n; ++i)
             {
-                val = (val << 8) | m_code[i];
+                val = (val << 8) | code[i];
             }
 
 #if EVM_USE_CONSTANT_POOL
@@ -113,16 +231,16 @@ void VM::optimize()
             // followed by one byte count of remaining pushed bytes
             if (5 < nPush)
             {
-                uint16_t pool_off = m_pool.size();
+                uint16_t pool_off = o_analyzed.pool.size();
                 TRACE_VAL(1, "stash", val);
                 TRACE_VAL(1, "... in pool at offset", pool_off);
-                m_pool.push_back(val);
+                o_analyzed.pool.push_back(val);
 
                 TRACE_PRE_OPT(1, pc, op);
-                m_code[pc] = byte(op = Instruction::PUSHC);
-                m_code[pc + 3] = nPush - 2;
-                m_code[pc + 2] = pool_off & 0xff;
-                m_code[pc + 1] = pool_off >> 8;
+                code[pc] = byte(op = Instruction::PUSHC);
+                code[pc + 3] = nPush - 2;
+                code[pc + 2] = pool_off & 0xff;
+                code[pc + 1] = pool_off >> 8;
                 TRACE_POST_OPT(1, pc, op);
             }
 
@@ -130,18 +248,17 @@ void VM::optimize()
 
 #if EVM_REPLACE_CONST_JUMP
             // replace JUMP or JUMPI to constant location with JUMPC or JUMPCI
-            // verifyJumpDest is M = log(number of jump destinations)
-            // outer loop is N = number of bytes in code array
-            // so complexity is N log M, worst case is N log N
+            // verifyJumpDest is a lookup in the jump destination bitmap
+            // so complexity is N = number of bytes in code array
             size_t i = pc + nPush + 1;
-            op = Instruction(m_code[i]);
+            op = Instruction(code[i]);
             if (op == Instruction::JUMP)
             {
                 TRACE_VAL(1, "Replace const JUMP with JUMPC to", val)
                 TRACE_PRE_OPT(1, i, op);
 
                 if (0 <= verifyJumpDest(val, false))
-                    m_code[i] = byte(op = Instruction::JUMPC);
+                    code[i] = byte(op = Instruction::JUMPC);
 
                 TRACE_POST_OPT(1, i, op);
             }
@@ -151,7 +268,7 @@ void VM::optimize()
                 TRACE_PRE_OPT(1, i, op);
 
                 if (0 <= verifyJumpDest(val, false))
-                    m_code[i] = byte(op = Instruction::JUMPCI);
+                    code[i] = byte(op = Instruction::JUMPCI);
 
                 TRACE_POST_OPT(1, i, op);
             }
@@ -170,7 +287,8 @@ void VM::optimize()
 //
 void VM::initEntry()
 {
-    m_bounce = &VM::interpretCases;
+    m_interpret = interpreter(m_rev);
+    m_bounce = m_interpret;
     initMetrics();
     optimize();
 }
@@ -189,8 +307,8 @@ u256 VM::exp256(u256 _base, u256 _exponent)
     while (_exponent)
     {
         if (static_cast<limb_type>(_exponent) & 1)  // If exponent is odd.
-            result *= _base;
-        _base *= _base;
+            arith256::mul(result, _base, result);
+        arith256::mul(_base, _base, _base);
         _exponent >>= 1;
     }
     return result;
@@ -109,6 +109,7 @@ void DBInitializer::createExecutiveContext()
     m_executiveContextFac->setStateStorage(m_storage);
     // mpt or storage
     m_executiveContextFac->setStateFactory(m_stateFactory);
+    m_executiveContextFac->setChainVersion(m_param->mutableGenesisParam().chainVersion);
     DBInitializer_LOG(DEBUG) << "[#createExecutiveContext SUCC]" << std::endl;
 }
 
@@ -135,7 +136,8 @@ void DBInitializer::createStateFactory(dev::h256 const& genesisHash)
 void DBInitializer::createStorageState()
 {
     DBInitializer_LOG(DEBUG) << "[#createStateFactory] [#createStorageState]" << std::endl;
-    m_stateFactory = std::make_shared<StorageStateFactory>(u256(0x0));
+    m_stateFactory = std::make_shared<StorageStateFactory>(
+        u256(0x0), m_param->mutableGenesisParam().chainVersion);
     DBInitializer_LOG(DEBUG) << "[#createStateFactory] [#createStorageState SUCC]" << std::endl;
 }
 
@@ -128,13 +128,20 @@ void Ledger::initConsensusConfig(ptree const& pt)
 
     m_param->mutableConsensusParam().maxTransactions =
         pt.get<uint64_t>("consensus.maxTransNum", 1000);
+    /// the groups configured before the compact prepare keep sending the full prepare, which the
+    /// older nodes still understand
+    m_param->mutableConsensusParam().compactPrepare =
+        pt.get<bool>("consensus.compactPrepare", false);
+    m_param->mutableConsensusParam().pipeline = pt.get<bool>("consensus.pipeline", false);
 
     // m_param->mutableConsensusParam().intervalBlockTime =
     ///    pt.get<unsigned>("consensus.intervalBlockTime", 1000);
 
-    Ledger_LOG(DEBUG) << "[#initConsensusConfig] [type/maxTxNum]:  "
+    Ledger_LOG(DEBUG) << "[#initConsensusConfig] [type/maxTxNum/compactPrepare/pipeline]:  "
                       << m_param->mutableConsensusParam().consensusType << "/"
-                      << m_param->mutableConsensusParam().maxTransactions << std::endl;
+                      << m_param->mutableConsensusParam().maxTransactions << "/"
+                      << m_param->mutableConsensusParam().compactPrepare << "/"
+                      << m_param->mutableConsensusParam().pipeline << std::endl;
     try
     {
         for (auto it : pt.get_child("consensus"))
@@ -168,6 +175,14 @@ void Ledger::initSyncConfig(ptree const& pt)
 /// dbType: leveldb/AMDB, storage type, default is "AMDB"
 /// mpt: true/false, enable mpt or not, default is true
 /// dbpath: data to place all data of the group, default is "data"
+/// parallelThreads: threads executing transactions in parallel, only used by the storage state
+/// of the chains of version 1, default is 0
+/// callThreads: threads executing the calls, default is 0 to execute them on the rpc threads
+/// maxPendingCalls: calls beyond it waiting or executing are rejected, default is 1000
+/// callCacheMB: memory limit in MB of the call result cache, default is 0 to disable it
+/// profileBlocks: the last executed blocks whose transactions are profiled, default is 0 to
+/// disable the profiler
+/// profileLogInterval: log the costliest contracts every such profiled blocks, default is 100
 void Ledger::initDBConfig(ptree const& pt)
 {
     /// init the basic config
@@ -178,10 +193,26 @@ void Ledger::initDBConfig(ptree const& pt)
     m_param->mutableStorageParam().path = baseDir;
     /// set state db related param
     m_param->mutableStateParam().type = pt.get<std::string>("state.type", "mpt");
+    m_param->mutableStateParam().parallelThreads = pt.get<unsigned>("state.parallelThreads", 0);
+    m_param->mutableStateParam().callThreads = pt.get<unsigned>("state.callThreads", 0);
+    m_param->mutableStateParam().maxPendingCalls =
+        pt.get<unsigned>("state.maxPendingCalls", 1000);
+    m_param->mutableStateParam().callCacheMB = pt.get<unsigned>("state.callCacheMB", 0);
+    m_param->mutableStateParam().profileBlocks = pt.get<unsigned>("state.profileBlocks", 0);
+    m_param->mutableStateParam().profileLogInterval =
+        pt.get<unsigned>("state.profileLogInterval", 100);
 
-    Ledger_LOG(DEBUG) << "[#initDBConfig] [storageDB/storagePath/stateDB/baseDir]:  "
+    Ledger_LOG(DEBUG) << "[#initDBConfig] [storageDB/storagePath/stateDB/baseDir/"
+                         "parallelThreads/callThreads/maxPendingCalls/"
+                         "callCacheMB/profileBlocks/profileLogInterval]:  "
                       << m_param->mutableStorageParam().type << "/"
-                      << m_param->mutableStorageParam().path << "/" << baseDir << std::endl;
+                      << m_param->mutableStorageParam().path << "/" << baseDir << "/"
+                      << m_param->mutableStateParam().parallelThreads << "/"
+                      << m_param->mutableStateParam().callThreads << "/"
+                      << m_param->mutableStateParam().maxPendingCalls << "/"
+                      << m_param->mutableStateParam().callCacheMB << "/"
+                      << m_param->mutableStateParam().profileBlocks << "/"
+                      << m_param->mutableStateParam().profileLogInterval << std::endl;
 }
 
 /// init genesis configuration
@@ -189,8 +220,10 @@ void Ledger::initGenesisConfig(ptree const& pt)
 {
     m_param->mutableGenesisParam().genesisMark =
         pt.get<std::string>("genesis.mark", std::to_string(m_groupId));
-    Ledger_LOG(DEBUG) << "[#initGenesisConfig] [genesisMark]:  "
-                      << m_param->mutableGenesisParam().genesisMark << std::endl;
+    m_param->mutableGenesisParam().chainVersion = pt.get<unsigned>("genesis.chainVersion", 0);
+    Ledger_LOG(DEBUG) << "[#initGenesisConfig] [genesisMark/chainVersion]:  "
+                      << m_param->mutableGenesisParam().genesisMark << "/"
+                      << m_param->mutableGenesisParam().chainVersion << std::endl;
 }
 
 /// init txpool
@@ -226,6 +259,38 @@ bool Ledger::initBlockVerifier()
     std::shared_ptr<BlockChainImp> blockChain =
         std::dynamic_pointer_cast<BlockChainImp>(m_blockChain);
     blockVerifier->setNumberHash(boost::bind(&BlockChainImp::numberHash, blockChain, _1));
+    /// the receipts of the chains before version 1 and of the mpt state hold the state root of
+    /// every transaction, it's part of the receipt root so it's never a local choice
+    blockVerifier->setIntermediateStateRoot(
+        m_param->mutableGenesisParam().chainVersion == 0 ||
+        dev::stringCmpIgnoreCase(m_param->mutableStateParam().type, "storage") != 0);
+    blockVerifier->setCallExecution(m_param->mutableStateParam().callThreads,
+        m_param->mutableStateParam().maxPendingCalls);
+    if (m_param->mutableStateParam().callCacheMB > 0)
+    {
+        auto callCache = std::make_shared<CallCache>(
+            (size_t)m_param->mutableStateParam().callCacheMB * 1024 * 1024);
+        blockVerifier->setCallCache(callCache);
+        // the results of the calls on the previous blocks won't be hit anymore
+        m_callCacheCleaner = m_blockChain->onReady([this, callCache]() {
+            Ledger_LOG(DEBUG) << "[#CallCache] [hits/misses/bytes]:  " << callCache->hits() << "/"
+                              << callCache->misses() << "/" << callCache->bytes() << std::endl;
+            callCache->clear();
+        });
+    }
+    if (m_param->mutableStateParam().profileBlocks > 0)
+    {
+        blockVerifier->setProfiler(
+            std::make_shared<ExecutionProfiler>(m_param->mutableStateParam().profileBlocks,
+                m_param->mutableStateParam().profileLogInterval));
+    }
+    /// conflicts are detected on the tables of the storage state, which can also be snapshotted
+    /// before it is committed
+    if (dev::stringCmpIgnoreCase(m_param->mutableStateParam().type, "storage") == 0)
+    {
+        blockVerifier->setParallelExecution(m_param->mutableStateParam().parallelThreads);
+        blockVerifier->setChainedExecution(true);
+    }
     m_blockVerifier = blockVerifier;
     Ledger_LOG(DEBUG) << "[#initLedger] [#initBlockVerifier SUCC]" << std::endl;
     return true;
@@ -240,11 +305,27 @@ bool Ledger::initBlockChain()
                           << std::endl;
         return false;
     }
+    if (m_param->mutableGenesisParam().chainVersion > dev::eth::c_chainVersion)
+    {
+        Ledger_LOG(ERROR) << "[#initLedger] [#initBlockChain Failed for unsupported chainVersion]"
+                          << std::endl;
+        return false;
+    }
     std::shared_ptr<BlockChainImp> blockChain = std::make_shared<BlockChainImp>();
     blockChain->setStateStorage(m_dbInitializer->storage());
+    blockChain->setChainVersion(m_param->mutableGenesisParam().chainVersion);
     m_blockChain = blockChain;
     m_blockChain->setGroupMark(m_param->mutableGenesisParam().genesisMark);
-    Ledger_LOG(DEBUG) << "[#initLedger] [#initBlockChain SUCC]";
+    /// an existing chain keeps the version of its genesis block whatever the config says
+    m_param->mutableGenesisParam().chainVersion = blockChain->chainVersion();
+    if (m_param->mutableGenesisParam().chainVersion > dev::eth::c_chainVersion)
+    {
+        Ledger_LOG(ERROR) << "[#initLedger] [#initBlockChain Failed for unsupported chainVersion]"
+                          << std::endl;
+        return false;
+    }
+    Ledger_LOG(DEBUG) << "[#initLedger] [#initBlockChain SUCC] [chainVersion]:  "
+                      << m_param->mutableGenesisParam().chainVersion;
     return true;
 }
 
@@ -276,6 +357,16 @@ std::shared_ptr<Sealer> Ledger::createPBFTSealer()
     pbftEngine->setIntervalBlockTime(SystemConfigMgr::c_intervalBlockTime);
     pbftEngine->setStorage(m_dbInitializer->storage());
     pbftEngine->setOmitEmptyBlock(SystemConfigMgr::c_omitEmptyBlock);
+    pbftEngine->setCompactPrepare(m_param->mutableConsensusParam().compactPrepare);
+    /// the next block is executed on the snapshot of the storage state
+    bool pipeline = m_param->mutableConsensusParam().pipeline;
+    if (pipeline && dev::stringCmpIgnoreCase(m_param->mutableStateParam().type, "storage") != 0)
+    {
+        Ledger_LOG(WARNING) << "[#createPBFTSealer] Pipeline disabled, it needs the storage state"
+                            << std::endl;
+        pipeline = false;
+    }
+    pbftEngine->setPipeline(pipeline);
     return pbftSealer;
 }
 
@@ -157,6 +157,8 @@ protected:
     std::shared_ptr<dev::sync::SyncInterface> m_sync = nullptr;
 
     std::shared_ptr<dev::ledger::DBInitializer> m_dbInitializer = nullptr;
+    /// clears the call result cache when a block is committed
+    dev::eth::Handler<> m_callCacheCleaner;
 };
 }  // namespace ledger
 }  // namespace dev
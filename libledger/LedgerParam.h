@@ -41,6 +41,10 @@ struct ConsensusParam
     std::string consensusType;
     dev::h512s minerList = dev::h512s();
     uint64_t maxTransactions;
+    /// broadcast the prepare requests as the block header and the transaction hashes
+    bool compactPrepare = false;
+    /// propose and execute the next block before the current block is committed
+    bool pipeline = false;
     /// unsigned intervalBlockTime;
 };
 
@@ -60,6 +64,8 @@ struct SyncParam
 struct GenesisParam
 {
     std::string genesisMark;
+    /// version of the chain, read from the genesis block once it exists
+    unsigned chainVersion;
 };
 struct StorageParam
 {
@@ -69,6 +75,18 @@ struct StorageParam
 struct StateParam
 {
     std::string type;
+    /// threads executing the transactions of a block speculatively, 0 executes them one by one
+    unsigned parallelThreads = 0;
+    /// threads executing the calls, 0 executes them on the rpc threads
+    unsigned callThreads = 0;
+    /// the calls beyond it waiting or executing are rejected, 0 for no limit
+    unsigned maxPendingCalls = 1000;
+    /// memory limit in MB of the call result cache, 0 to disable
+    unsigned callCacheMB = 0;
+    /// the last executed blocks whose transactions are profiled, 0 to disable
+    unsigned profileBlocks = 0;
+    /// log the costliest contracts every such profiled blocks, 0 to disable
+    unsigned profileLogInterval = 100;
 };
 class LedgerParam : public LedgerParamInterface
 {
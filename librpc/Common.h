@@ -38,12 +38,14 @@ enum RPCExceptionType
     BlockHash,
     BlockNumberT,
     TransactionIndex,
-    CallFrom
+    CallFrom,
+    CallRejected,
+    ProfilerDisabled
 };
 
 const std::string RPCMsg[] = {"Success", "GroupID does not exist", "Response json parse error",
     "BlockHash does not exist", "BlockNumber does not exist", "TransactionIndex is out of range",
-    "Call needs a 'from' field"};
+    "Call needs a 'from' field", "Too many pending calls", "Execution profiler is disabled"};
 
 }  // namespace rpc
 }  // namespace dev
@@ -28,6 +28,8 @@
 #include <libdevcore/easylog.h>
 #include <libethcore/Common.h>
 #include <libethcore/CommonJS.h>
+#include <libethcore/Exceptions.h>
+#include <libethcore/Instruction.h>
 #include <libethcore/Transaction.h>
 #include <libexecutive/ExecutionResult.h>
 #include <libstorage/MinerPrecompiled.h>
@@ -791,9 +793,9 @@ Json::Value Rpc::call(int _groupID, const Json::Value& request)
             BOOST_THROW_EXCEPTION(
                 JsonRpcException(RPCExceptionType::GroupID, RPCMsg[RPCExceptionType::GroupID]));
 
-        BlockNumber blockNumber = blockchain->number();
-        auto block = blockchain->getBlockByNumber(blockNumber);
-        if (!block)
+        // the header is cached by the block chain, and the calls run on its state
+        auto blockHeader = blockchain->headHeader();
+        if (!blockHeader)
             BOOST_THROW_EXCEPTION(JsonRpcException(
                 RPCExceptionType::BlockNumberT, RPCMsg[RPCExceptionType::BlockNumberT]));
 
@@ -801,12 +803,11 @@ Json::Value Rpc::call(int _groupID, const Json::Value& request)
         Transaction tx(txSkeleton.value, dev::config::SystemConfigMgr::maxTransactionGasLimit,
             dev::config::SystemConfigMgr::maxTransactionGasLimit, txSkeleton.to, txSkeleton.data,
             txSkeleton.nonce);
-        auto blockHeader = block->header();
         tx.forceSender(txSkeleton.from);
-        auto executionResult = blockverfier->executeTransaction(blockHeader, tx);
+        auto executionResult = blockverfier->executeCall(*blockHeader, tx);
 
         Json::Value response;
-        response["currentBlockNumber"] = toJS(blockNumber);
+        response["currentBlockNumber"] = toJS(blockHeader->number());
         response["output"] = toJS(executionResult.first.output);
         return response;
     }
@@ -814,6 +815,11 @@ Json::Value Rpc::call(int _groupID, const Json::Value& request)
     {
         throw e;
     }
+    catch (dev::eth::TooManyPendingCalls&)
+    {
+        BOOST_THROW_EXCEPTION(JsonRpcException(
+            RPCExceptionType::CallRejected, RPCMsg[RPCExceptionType::CallRejected]));
+    }
     catch (std::exception& e)
     {
         BOOST_THROW_EXCEPTION(
@@ -850,4 +856,79 @@ std::string Rpc::sendRawTransaction(int _groupID, const std::string& _rlp)
         BOOST_THROW_EXCEPTION(
             JsonRpcException(Errors::ERROR_RPC_INTERNAL_ERROR, boost::diagnostic_information(e)));
     }
+}
+
+namespace
+{
+Json::Value profileToJson(dev::blockverifier::TransactionProfile const& _profile)
+{
+    Json::Value profile;
+    profile["timeUs"] = toJS(_profile.timeUs);
+    profile["gasUsed"] = toJS(_profile.gasUsed);
+    profile["selects"] = toJS(_profile.selects);
+    profile["loads"] = toJS(_profile.loads);
+    profile["writes"] = toJS(_profile.writes);
+    profile["precompiledCalls"] = toJS(_profile.precompiledCalls);
+    Json::Value opcodes(Json::objectValue);
+    for (size_t i = 0; i < _profile.opcodes.size(); ++i)
+    {
+        if (_profile.opcodes[i] == 0)
+            continue;
+        auto name = dev::eth::instructionInfo((dev::eth::Instruction)i).name;
+        opcodes[name] = toJS(_profile.opcodes[i]);
+    }
+    profile["opcodes"] = opcodes;
+    return profile;
+}
+}  // namespace
+
+Json::Value Rpc::getExecutionProfile(int _groupID)
+{
+    try
+    {
+        LOG(INFO) << "getExecutionProfile # request = " << std::endl
+                  << "{ " << std::endl
+                  << "\"_groupID\" : " << _groupID << std::endl
+                  << "}";
+
+        auto blockverfier = ledgerManager()->blockVerifier(_groupID);
+        if (!blockverfier)
+            BOOST_THROW_EXCEPTION(
+                JsonRpcException(RPCExceptionType::GroupID, RPCMsg[RPCExceptionType::GroupID]));
+        auto profiler = blockverfier->profiler();
+        if (!profiler)
+            BOOST_THROW_EXCEPTION(JsonRpcException(
+                RPCExceptionType::ProfilerDisabled, RPCMsg[RPCExceptionType::ProfilerDisabled]));
+
+        Json::Value response(Json::arrayValue);
+        for (auto const& block : profiler->blockProfiles())
+        {
+            Json::Value blockJson;
+            blockJson["number"] = toJS(block->number);
+            blockJson["timeUs"] = toJS(block->timeUs);
+            blockJson["hashUs"] = toJS(block->hashUs);
+            blockJson["transactions"] = toJS(block->transactions);
+            blockJson["executions"] = toJS(block->executions.size());
+            blockJson["total"] = profileToJson(block->total);
+            Json::Value contracts(Json::arrayValue);
+            for (auto const& it : block->contracts)
+            {
+                Json::Value contract = profileToJson(it.second);
+                contract["address"] = toJS(it.first);
+                contracts.append(contract);
+            }
+            blockJson["contracts"] = contracts;
+            response.append(blockJson);
+        }
+        return response;
+    }
+    catch (JsonRpcException& e)
+    {
+        throw e;
+    }
+    catch (std::exception& e)
+    {
+        BOOST_THROW_EXCEPTION(
+            JsonRpcException(Errors::ERROR_RPC_INTERNAL_ERROR, boost::diagnostic_information(e)));
+    }
 }
\ No newline at end of file
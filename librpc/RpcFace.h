@@ -111,6 +111,10 @@ public:
             jsonrpc::Procedure("getTotalTransactionCount", jsonrpc::PARAMS_BY_POSITION,
                 jsonrpc::JSON_OBJECT, "param1", jsonrpc::JSON_INTEGER, NULL),
             &dev::rpc::RpcFace::getTotalTransactionCountI);
+        this->bindAndAddMethod(
+            jsonrpc::Procedure("getExecutionProfile", jsonrpc::PARAMS_BY_POSITION,
+                jsonrpc::JSON_OBJECT, "param1", jsonrpc::JSON_INTEGER, NULL),
+            &dev::rpc::RpcFace::getExecutionProfileI);
     }
 
     inline virtual void getBlockNumberI(const Json::Value& request, Json::Value& response)
@@ -195,6 +199,10 @@ public:
     {
         response = this->getTotalTransactionCount(request[0u].asInt());
     }
+    inline virtual void getExecutionProfileI(const Json::Value& request, Json::Value& response)
+    {
+        response = this->getExecutionProfile(request[0u].asInt());
+    }
     inline virtual void callI(const Json::Value& request, Json::Value& response)
     {
         response = this->call(request[0u].asInt(), request[1u]);
@@ -244,6 +252,10 @@ public:
     virtual Json::Value call(int param1, const Json::Value& param2) = 0;
     /// Creates new message call transaction or a contract creation for signed transactions.
     virtual std::string sendRawTransaction(int param1, const std::string& param2) = 0;
+
+    // profiler part
+    /// Returns the profiles of the transactions of the last executed blocks.
+    virtual Json::Value getExecutionProfile(int param1) = 0;
 };
 
 }  // namespace rpc
@@ -22,7 +22,7 @@
 #include "libstorage/EntriesPrecompiled.h"
 #include "libstorage/TableFactoryPrecompiled.h"
 #include <libdevcore/easylog.h>
-#include <libethcore/ABI.h>
+#include <libethcore/ABICodec.h>
 
 using namespace dev;
 using namespace dev::blockverifier;
@@ -36,10 +36,7 @@ storage::Table::Ptr CRUDPrecompiled::openTable(
     ExecutiveContext::Ptr context, const std::string& tableName)
 {
     STORAGE_LOG(DEBUG) << "CRUD open table:" << tableName;
-    TableFactoryPrecompiled::Ptr tableFactoryPrecompiled =
-        std::dynamic_pointer_cast<TableFactoryPrecompiled>(
-            context->getPrecompiled(Address(0x1001)));
-    return tableFactoryPrecompiled->getmemoryTableFactory()->openTable(tableName);
+    return context->getMemoryTableFactory()->openTable(tableName);
 }
 
 bytes CRUDPrecompiled::call(ExecutiveContext::Ptr context, bytesConstRef param)
@@ -52,23 +49,46 @@ bytes CRUDPrecompiled::call(ExecutiveContext::Ptr context, bytesConstRef param)
 
     STORAGE_LOG(DEBUG) << "func:" << std::hex << func;
 
-    dev::eth::ContractABI abi;
     bytes out;
 
     switch (func)
     {
     case 0x73224cec:
     {  // select(string,string)
-        std::string tableName, key;
-        abi.abiOut(data, tableName, key);
-        storage::Table::Ptr table = openTable(context, tableName);
+        dev::eth::stringConstRef tableName, key;
+        dev::eth::ABICodec::decode(data, tableName, key);
+        storage::Table::Ptr table = openTable(context, tableName.toString());
         if (table.get())
         {
-            auto entries = table->select(key, table->newCondition());
+            auto entries = table->select(key.toString(), table->newCondition());
             auto entriesPrecompiled = std::make_shared<EntriesPrecompiled>();
             entriesPrecompiled->setEntries(entries);
             auto newAddress = context->registerPrecompiled(entriesPrecompiled);
-            out = abi.abiIn("", newAddress);
+            dev::eth::ABICodec::encode(out, newAddress);
+        }
+        break;
+    }
+    case 0x00f8a2ac:
+    {  // selectBatch(string,string[])
+        dev::eth::stringConstRef tableName;
+        std::vector<dev::eth::stringConstRef> keys;
+        dev::eth::ABICodec::decode(data, tableName, keys);
+        storage::Table::Ptr table = openTable(context, tableName.toString());
+        if (table.get())
+        {
+            // the entries of the keys in their order, in one entries precompiled
+            auto condition = table->newCondition();
+            auto entries = std::make_shared<storage::Entries>();
+            for (auto const& key : keys)
+            {
+                auto keyEntries = table->select(key.toString(), condition);
+                for (size_t i = 0; i < keyEntries->size(); ++i)
+                    entries->addEntry(keyEntries->get(i));
+            }
+            auto entriesPrecompiled = std::make_shared<EntriesPrecompiled>();
+            entriesPrecompiled->setEntries(entries);
+            auto newAddress = context->registerPrecompiled(entriesPrecompiled);
+            dev::eth::ABICodec::encode(out, newAddress);
         }
         break;
     }
@@ -80,3 +100,32 @@ bytes CRUDPrecompiled::call(ExecutiveContext::Ptr context, bytesConstRef param)
 
     return out;
 }
+
+ConflictKeys CRUDPrecompiled::conflictKeys(bytesConstRef param)
+{
+    ConflictKeys keys;
+    switch (getParamFunc(param))
+    {
+    case 0x73224cec:
+    {  // select(string,string)
+        dev::eth::stringConstRef tableName, key;
+        dev::eth::ABICodec::decode(getParamData(param), tableName, key);
+        keys.emplace_back(tableName.toString(), key.toString());
+        break;
+    }
+    case 0x00f8a2ac:
+    {  // selectBatch(string,string[])
+        dev::eth::stringConstRef tableName;
+        std::vector<dev::eth::stringConstRef> batchKeys;
+        dev::eth::ABICodec::decode(getParamData(param), tableName, batchKeys);
+        for (auto const& key : batchKeys)
+            keys.emplace_back(tableName.toString(), key.toString());
+        break;
+    }
+    default:
+    {
+        break;
+    }
+    }
+    return keys;
+}
@@ -42,6 +42,8 @@ public:
 
     virtual bytes call(ExecutiveContext::Ptr context, bytesConstRef param);
 
+    virtual ConflictKeys conflictKeys(bytesConstRef param);
+
 protected:
     std::shared_ptr<storage::Table> openTable(
         ExecutiveContext::Ptr context, const std::string& tableName);
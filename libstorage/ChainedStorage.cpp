@@ -0,0 +1,104 @@
+/*
+    This file is part of FISCO-BCOS.
+
+    FISCO-BCOS is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FISCO-BCOS is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file ChainedStorage.cpp
+ *  @record storage of a block executed on its executed but uncommitted parent block
+ */
+#include "ChainedStorage.h"
+#include "StorageException.h"
+#include <libdevcore/easylog.h>
+#include <boost/lexical_cast.hpp>
+
+using namespace std;
+using namespace dev;
+using namespace dev::storage;
+
+namespace
+{
+/// copies the entries which aren't deleted, the copies are clean
+Entries::Ptr copyEntries(Entries::Ptr _entries, map<string, string> const& _fields)
+{
+    Entries::Ptr copy = make_shared<Entries>();
+    for (size_t i = 0; i < _entries->size(); ++i)
+    {
+        auto entry = _entries->get(i);
+        if (entry->getStatus() == Entry::Status::DELETED)
+            continue;
+        auto entryCopy = make_shared<Entry>(*entry);
+        for (auto const& field : _fields)
+            entryCopy->setField(field.first, field.second);
+        entryCopy->setDirty(false);
+        copy->addEntry(entryCopy);
+    }
+    copy->setDirty(false);
+    return copy;
+}
+}  // namespace
+
+ChainedStorage::ChainedStorage(
+    MemoryTableFactory::Ptr _memoryTableFactory, h256 const& _blockHash, int64_t _blockNumber)
+  : m_storage(_memoryTableFactory->stateStorage()),
+    m_blockHash(_blockHash),
+    m_blockNumber(_blockNumber)
+{
+    // the fields set by the storage when committing
+    map<string, string> fields{{"_hash_", _blockHash.hex()},
+        {"_num_", boost::lexical_cast<string>(_blockNumber)}};
+    for (auto const& tableData : _memoryTableFactory->dirtyTables())
+    {
+        auto snapshot = make_shared<TableData>();
+        snapshot->tableName = tableData->tableName;
+        for (auto const& it : tableData->data)
+        {
+            snapshot->data.insert(make_pair(it.first, copyEntries(it.second, fields)));
+        }
+        m_data.insert(make_pair(tableData->tableName, snapshot));
+    }
+}
+
+Entries::Ptr ChainedStorage::select(
+    h256 hash, int num, const std::string& table, const std::string& key)
+{
+    checkAborted();
+    auto tableData = m_data.find(table);
+    if (tableData != m_data.end())
+    {
+        auto entries = tableData->second->data.find(key);
+        if (entries != tableData->second->data.end())
+        {
+            // the tables of the executing block modify the entries they load
+            return copyEntries(entries->second, map<string, string>());
+        }
+    }
+    return m_storage->select(hash, num, table, key);
+}
+
+size_t ChainedStorage::commit(
+    h256 hash, int64_t num, const std::vector<TableData::Ptr>& datas, h256 blockHash)
+{
+    checkAborted();
+    return m_storage->commit(hash, num, datas, blockHash);
+}
+
+void ChainedStorage::checkAborted() const
+{
+    if (m_aborted)
+    {
+        STORAGE_LOG(WARNING) << "ChainedStorage of aborted block, number: " << m_blockNumber
+                             << " hash: " << m_blockHash;
+        BOOST_THROW_EXCEPTION(StorageException(-1, "The parent block is aborted"));
+    }
+}
@@ -0,0 +1,75 @@
+/*
+    This file is part of FISCO-BCOS.
+
+    FISCO-BCOS is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FISCO-BCOS is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file ChainedStorage.h
+ *  @record storage of a block executed on its executed but uncommitted parent block
+ */
+#pragma once
+
+#include "MemoryTableFactory.h"
+#include "Storage.h"
+#include <atomic>
+
+namespace dev
+{
+namespace storage
+{
+/**
+ * @brief Snapshot of the data written by an executed block, on top of the state storage it was
+ * executed on. The next block can be executed on it while the block is committed. The entries
+ * look like committed ones: clean, without deleted entries and with the hash and number of the
+ * block. The rows written by the block chain when committing the block aren't included.
+ * If the block fails to commit, abort() makes reading or committing through the snapshot throw.
+ */
+class ChainedStorage : public Storage
+{
+public:
+    typedef std::shared_ptr<ChainedStorage> Ptr;
+
+    /// copies the data of _memoryTableFactory, which mustn't be written concurrently
+    ChainedStorage(
+        MemoryTableFactory::Ptr _memoryTableFactory, h256 const& _blockHash, int64_t _blockNumber);
+
+    virtual ~ChainedStorage(){};
+
+    virtual Entries::Ptr select(
+        h256 hash, int num, const std::string& table, const std::string& key) override;
+    /// commits to the underlying storage, the snapshotted block must be committed before
+    virtual size_t commit(
+        h256 hash, int64_t num, const std::vector<TableData::Ptr>& datas, h256 blockHash) override;
+    virtual bool onlyDirty() override { return m_storage->onlyDirty(); }
+
+    void abort() { m_aborted = true; }
+    bool aborted() const { return m_aborted; }
+
+    h256 const& blockHash() const { return m_blockHash; }
+    int64_t blockNumber() const { return m_blockNumber; }
+    /// the storage the snapshotted block was executed on
+    Storage::Ptr storage() const { return m_storage; }
+
+private:
+    void checkAborted() const;
+
+    Storage::Ptr m_storage;
+    h256 m_blockHash;
+    int64_t m_blockNumber;
+    std::map<std::string, TableData::Ptr> m_data;
+    std::atomic<bool> m_aborted = {false};
+};
+
+}  // namespace storage
+
+}  // namespace dev
@@ -38,5 +38,6 @@ const std::string SYS_VALUE = "value";
 const std::string SYS_TX_HASH_2_BLOCK = "_sys_tx_hash_2_block_";
 const std::string SYS_NUMBER_2_HASH = "_sys_number_2_hash_";
 const std::string SYS_HASH_2_BLOCK = "_sys_hash_2_block_";
+const std::string SYS_HASH_2_CODE = "_sys_hash_2_code_";
 }  // namespace storage
 }  // namespace dev
\ No newline at end of file
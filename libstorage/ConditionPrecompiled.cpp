@@ -21,7 +21,7 @@
 #include "ConditionPrecompiled.h"
 #include "Common.h"
 #include <libdevcore/easylog.h>
-#include <libethcore/ABI.h>
+#include <libethcore/ABICodec.h>
 
 using namespace dev;
 using namespace dev::blockverifier;
@@ -42,8 +42,6 @@ bytes ConditionPrecompiled::call(std::shared_ptr<ExecutiveContext> context, byte
 
     STORAGE_LOG(DEBUG) << "func:" << std::hex << func;
 
-    dev::eth::ContractABI abi;
-
     bytes out;
 
     assert(m_condition);
@@ -51,88 +49,88 @@ bytes ConditionPrecompiled::call(std::shared_ptr<ExecutiveContext> context, byte
     {
     case 0xe44594b9:
     {  // EQ(string,int256)
-        std::string str;
+        dev::eth::stringConstRef str;
         u256 num;
-        abi.abiOut(data, str, num);
+        dev::eth::ABICodec::decode(data, str, num);
 
-        m_condition->EQ(str, boost::lexical_cast<std::string>(num));
+        m_condition->EQ(str.toString(), boost::lexical_cast<std::string>(num));
 
         break;
     }
     case 0xcd30a1d1:
     {  // EQ(string,string)
-        std::string str;
-        std::string value;
-        abi.abiOut(data, str, value);
+        dev::eth::stringConstRef str;
+        dev::eth::stringConstRef value;
+        dev::eth::ABICodec::decode(data, str, value);
 
-        m_condition->EQ(str, value);
+        m_condition->EQ(str.toString(), value.toString());
 
         break;
     }
     case 0x42f8dd31:
     {  // GE(string,int256)
-        std::string str;
+        dev::eth::stringConstRef str;
         u256 value;
-        abi.abiOut(data, str, value);
+        dev::eth::ABICodec::decode(data, str, value);
 
-        m_condition->GE(str, boost::lexical_cast<std::string>(value));
+        m_condition->GE(str.toString(), boost::lexical_cast<std::string>(value));
 
         break;
     }
     case 0x08ad6333:
     {  // GT(string,int256)
-        std::string str;
+        dev::eth::stringConstRef str;
         u256 value;
-        abi.abiOut(data, str, value);
+        dev::eth::ABICodec::decode(data, str, value);
 
-        m_condition->GT(str, boost::lexical_cast<std::string>(value));
+        m_condition->GT(str.toString(), boost::lexical_cast<std::string>(value));
 
         break;
     }
     case 0xb6f23857:
     {  // LE(string,int256)
-        std::string str;
+        dev::eth::stringConstRef str;
         u256 value;
-        abi.abiOut(data, str, value);
+        dev::eth::ABICodec::decode(data, str, value);
 
-        m_condition->LE(str, boost::lexical_cast<std::string>(value));
+        m_condition->LE(str.toString(), boost::lexical_cast<std::string>(value));
 
         break;
     }
     case 0xc31c9b65:
     {  // LT(string,int256)
-        std::string str;
+        dev::eth::stringConstRef str;
         u256 value;
-        abi.abiOut(data, str, value);
+        dev::eth::ABICodec::decode(data, str, value);
 
-        m_condition->LT(str, boost::lexical_cast<std::string>(value));
+        m_condition->LT(str.toString(), boost::lexical_cast<std::string>(value));
 
         break;
     }
     case 0x39aef024:
     {  // NE(string,int256)
-        std::string str;
+        dev::eth::stringConstRef str;
         u256 num;
-        abi.abiOut(data, str, num);
+        dev::eth::ABICodec::decode(data, str, num);
 
-        m_condition->NE(str, boost::lexical_cast<std::string>(num));
+        m_condition->NE(str.toString(), boost::lexical_cast<std::string>(num));
 
         break;
     }
     case 0x2783acf5:
     {  // NE(string,string)
-        std::string str;
-        std::string value;
-        abi.abiOut(data, str, value);
+        dev::eth::stringConstRef str;
+        dev::eth::stringConstRef value;
+        dev::eth::ABICodec::decode(data, str, value);
 
-        m_condition->NE(str, value);
+        m_condition->NE(str.toString(), value.toString());
 
         break;
     }
     case 0x2e0d738a:
     {  // limit(int256)
         u256 num;
-        abi.abiOut(data, num);
+        dev::eth::ABICodec::decode(data, num);
 
         m_condition->limit(num.convert_to<size_t>());
 
@@ -142,7 +140,7 @@ bytes ConditionPrecompiled::call(std::shared_ptr<ExecutiveContext> context, byte
     {  // limit(int256,int256)
         u256 offset;
         u256 size;
-        abi.abiOut(data, offset, size);
+        dev::eth::ABICodec::decode(data, offset, size);
 
         m_condition->limit(offset.convert_to<size_t>(), size.convert_to<size_t>());
 
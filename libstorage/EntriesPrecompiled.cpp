@@ -21,7 +21,7 @@
 #include "EntriesPrecompiled.h"
 #include "EntryPrecompiled.h"
 #include <libdevcore/easylog.h>
-#include <libethcore/ABI.h>
+#include <libethcore/ABICodec.h>
 
 using namespace dev;
 using namespace dev::blockverifier;
@@ -42,8 +42,6 @@ bytes dev::blockverifier::EntriesPrecompiled::call(
 
     STORAGE_LOG(DEBUG) << "func:" << std::hex << func;
 
-    dev::eth::ContractABI abi;
-
     bytes out;
 
     switch (func)
@@ -51,14 +49,14 @@ bytes dev::blockverifier::EntriesPrecompiled::call(
     case 0x846719e0:
     {  // get(int256)
         u256 num;
-        abi.abiOut(data, num);
+        dev::eth::ABICodec::decode(data, num);
 
         auto entry = m_entries->get(num.convert_to<size_t>());
         EntryPrecompiled::Ptr entryPrecompiled = std::make_shared<EntryPrecompiled>();
         entryPrecompiled->setEntry(entry);
         Address address = context->registerPrecompiled(entryPrecompiled);
 
-        out = abi.abiIn("", address);
+        dev::eth::ABICodec::encode(out, address);
 
         break;
     }
@@ -66,7 +64,7 @@ bytes dev::blockverifier::EntriesPrecompiled::call(
     {  // size()
         u256 c = m_entries->size();
 
-        out = abi.abiIn("", c);
+        dev::eth::ABICodec::encode(out, c);
 
         break;
     }
@@ -20,7 +20,7 @@
  */
 #include "EntryPrecompiled.h"
 #include <libdevcore/easylog.h>
-#include <libethcore/ABI.h>
+#include <libethcore/ABICodec.h>
 
 using namespace dev;
 using namespace dev::blockverifier;
@@ -41,65 +41,63 @@ bytes EntryPrecompiled::call(std::shared_ptr<ExecutiveContext> context, bytesCon
 
     STORAGE_LOG(DEBUG) << "func:" << std::hex << func;
 
-    dev::eth::ContractABI abi;
-
     bytes out;
 
     switch (func)
     {
     case 0xfda69fae:
     {  // getInt(string)
-        std::string str;
-        abi.abiOut(data, str);
+        dev::eth::stringConstRef str;
+        dev::eth::ABICodec::decode(data, str);
 
-        std::string value = m_entry->getField(str);
+        std::string value = m_entry->getField(str.toString());
 
         u256 num = boost::lexical_cast<u256>(value);
-        out = abi.abiIn("", num);
+        dev::eth::ABICodec::encode(out, num);
 
         break;
     }
     case 0x2ef8ba74:
     {  // set(string,int256)
-        std::string str;
+        dev::eth::stringConstRef str;
         u256 value;
-        abi.abiOut(data, str, value);
+        dev::eth::ABICodec::decode(data, str, value);
 
-        m_entry->setField(str, boost::lexical_cast<std::string>(value));
+        m_entry->setField(str.toString(), boost::lexical_cast<std::string>(value));
 
         break;
     }
     case 0xe942b516:
     {  // set(string,string)
-        std::string str;
-        std::string value;
-        abi.abiOut(data, str, value);
+        dev::eth::stringConstRef str;
+        dev::eth::stringConstRef value;
+        dev::eth::ABICodec::decode(data, str, value);
 
-        m_entry->setField(str, value);
+        m_entry->setField(str.toString(), value.toString());
 
         break;
     }
     case 0xbf40fac1:
     {  // getAddress(string)
-        std::string str;
-        abi.abiOut(data, str);
+        dev::eth::stringConstRef str;
+        dev::eth::ABICodec::decode(data, str);
 
-        std::string value = m_entry->getField(str);
+        std::string value = m_entry->getField(str.toString());
         Address ret = Address(value);
-        out = abi.abiIn("", ret);
+        dev::eth::ABICodec::encode(out, ret);
         break;
     }
     case 0xd52decd4:
     {  //"getBytes64(string)"
-        std::string str;
-        abi.abiOut(data, str);
+        dev::eth::stringConstRef str;
+        dev::eth::ABICodec::decode(data, str);
 
-        std::string value = m_entry->getField(str);
+        std::string value = m_entry->getField(str.toString());
         string64 ret;
         for (unsigned i = 0; i < 64; ++i)
             ret[i] = i < value.size() ? value[i] : 0;
 
-        out = abi.abiIn("", ret);
+        dev::eth::ABICodec::encode(out, ret);
         break;
     }
     default:
@@ -38,6 +38,8 @@ Entries::Ptr dev::storage::MemoryTable::select(const std::string& key, Condition
 {
     try
     {
+        if (m_accessStats)
+            ++m_accessStats->selects;
         Entries::Ptr entries = std::make_shared<Entries>();
 
         auto it = m_cache.find(key);
@@ -51,6 +53,7 @@ Entries::Ptr dev::storage::MemoryTable::select(const std::string& key, Condition
                     << m_tableInfo->name << " selects:" << entries->size() << " record(s)";
 
                 m_cache.insert(std::make_pair(key, entries));
+                recordSelect(key);
             }
         }
         else
@@ -98,6 +101,7 @@ size_t dev::storage::MemoryTable::update(
                 /// STORAGE_LOG(DEBUG) << "AMOPDB selects:" << entries->size() << " record(s)";
 
                 m_cache.insert(std::make_pair(key, entries));
+                recordSelect(key);
             }
         }
         else
@@ -157,6 +161,7 @@ size_t dev::storage::MemoryTable::insert(const std::string& key, Entry::Ptr entr
                 /// STORAGE_LOG(DEBUG) << "AMOPDB selects:" << entries->size() << " record(s)";
 
                 m_cache.insert(std::make_pair(key, entries));
+                recordSelect(key);
             }
         }
         else
@@ -203,6 +208,7 @@ size_t dev::storage::MemoryTable::remove(const std::string& key, Condition::Ptr
             STORAGE_LOG(DEBUG) << "AMOPDB selects:" << entries->size() << " record(s)";
 
             m_cache.insert(std::make_pair(key, entries));
+            recordSelect(key);
         }
     }
     else
@@ -280,6 +286,15 @@ void dev::storage::MemoryTable::setStateStorage(Storage::Ptr amopDB)
     m_remoteDB = amopDB;
 }
 
+void MemoryTable::recordSelect(const std::string& key)
+{
+    if (m_recorder)
+    {
+        std::vector<Change::Record> records;
+        m_recorder(shared_from_this(), Change::Select, key, records);
+    }
+}
+
 std::vector<size_t> MemoryTable::processEntries(Entries::Ptr entries, Condition::Ptr condition)
 {
     std::vector<size_t> indexes;
@@ -49,8 +49,12 @@ public:
     void setBlockHash(h256 blockHash);
     void setBlockNum(int blockNum);
     void setTableInfo(TableInfo::Ptr tableInfo);
+    /// count the selects in _accessStats
+    void setAccessStats(TableAccessStats::Ptr _accessStats) { m_accessStats = _accessStats; }
 
 private:
+    /// reports a key loaded from the state storage to the recorder
+    void recordSelect(const std::string& key);
     std::vector<size_t> processEntries(Entries::Ptr entries, Condition::Ptr condition);
     bool processCondition(Entry::Ptr entry, Condition::Ptr condition);
     bool isHashField(const std::string& _key);
@@ -60,6 +64,7 @@ private:
     std::map<std::string, Entries::Ptr> m_cache;
     h256 m_blockHash;
     int m_blockNum = 0;
+    TableAccessStats::Ptr m_accessStats;
 };
 
 }  // namespace storage
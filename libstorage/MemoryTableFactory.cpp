@@ -21,6 +21,7 @@
 #include "MemoryTableFactory.h"
 #include "Common.h"
 #include "MemoryTable.h"
+#include "StorageException.h"
 #include "TablePrecompiled.h"
 #include <libblockverifier/ExecutiveContext.h>
 #include <libdevcore/easylog.h>
@@ -39,6 +40,7 @@ MemoryTableFactory::MemoryTableFactory() : m_blockHash(h256(0)), m_blockNum(0)
     m_sysTables.push_back(SYS_NUMBER_2_HASH);
     m_sysTables.push_back(SYS_TX_HASH_2_BLOCK);
     m_sysTables.push_back(SYS_HASH_2_BLOCK);
+    m_sysTables.push_back(SYS_HASH_2_CODE);
 }
 
 Table::Ptr MemoryTableFactory::openTable(const string& tableName)
@@ -79,9 +81,21 @@ Table::Ptr MemoryTableFactory::openTable(const string& tableName)
     memoryTable->setBlockHash(m_blockHash);
     memoryTable->setBlockNum(m_blockNum);
     memoryTable->setTableInfo(tableInfo);
-    memoryTable->setRecorder([&](Table::Ptr _table, Change::Kind _kind, string const& _key,
-                                 vector<Change::Record>& _records) {
-        m_changeLog.emplace_back(_table, _kind, _key, _records);
+    memoryTable->setAccessStats(m_accessStats);
+    memoryTable->setRecorder([this, tableName](Table::Ptr _table, Change::Kind _kind,
+                                 string const& _key, vector<Change::Record>& _records) {
+        if (_kind == Change::Select)
+            ++m_accessStats->loads;
+        else
+            ++m_accessStats->writes;
+        if (m_trackAccess)
+        {
+            auto& accessSet = _kind == Change::Select ? m_readSet : m_writeSet;
+            accessSet.insert(make_pair(tableName, _key));
+        }
+        // selects don't change anything, there is nothing to roll back
+        if (_kind != Change::Select)
+            m_changeLog.emplace_back(_table, _kind, _key, _records);
     });
 
     memoryTable->init(tableName);
@@ -202,10 +216,8 @@ void MemoryTableFactory::rollback(size_t _savepoint)
 
 void MemoryTableFactory::commit() {}
 
-void MemoryTableFactory::commitDB(h256 const& _blockHash, int64_t _blockNumber)
+vector<TableData::Ptr> MemoryTableFactory::dirtyTables()
 {
-    /// STORAGE_LOG(DEBUG) << "Submiting TablePrecompiled";
-
     vector<dev::storage::TableData::Ptr> datas;
 
     for (auto dbIt : m_name2Table)
@@ -231,6 +243,14 @@ void MemoryTableFactory::commitDB(h256 const& _blockHash, int64_t _blockNumber)
             datas.push_back(tableData);
         }
     }
+    return datas;
+}
+
+void MemoryTableFactory::commitDB(h256 const& _blockHash, int64_t _blockNumber)
+{
+    /// STORAGE_LOG(DEBUG) << "Submiting TablePrecompiled";
+
+    vector<dev::storage::TableData::Ptr> datas = dirtyTables();
 
     /// STORAGE_LOG(DEBUG) << "Total: " << datas.size() << " key";
     if (!datas.empty())
@@ -247,6 +267,77 @@ void MemoryTableFactory::commitDB(h256 const& _blockHash, int64_t _blockNumber)
     m_changeLog.clear();
 }
 
+void MemoryTableFactory::reset()
+{
+    m_stateStorage.reset();
+    m_blockHash = h256(0);
+    m_blockNum = 0;
+    m_name2Table.clear();
+    m_changeLog.clear();
+    m_hash = h256();
+    m_trackAccess = false;
+    clearAccessSet();
+}
+
+void MemoryTableFactory::clearAccessSet()
+{
+    m_readSet.clear();
+    m_writeSet.clear();
+}
+
+void MemoryTableFactory::applyWrites(MemoryTableFactory& _other)
+{
+    // tables created in _other can't be opened before their rows of _sys_tables_ are applied
+    auto apply = [&](bool _sysTables) {
+        for (auto const& it : _other.m_writeSet)
+        {
+            if ((it.first == SYS_TABLES) != _sysTables)
+            {
+                continue;
+            }
+            auto table = openTable(it.first);
+            if (!table)
+            {
+                BOOST_THROW_EXCEPTION(
+                    StorageException(-1, "Apply writes to nonexistent table: " + it.first));
+            }
+            auto source = _other.m_name2Table[it.first]->data();
+            auto entries = source->find(it.second);
+            if (entries != source->end())
+            {
+                (*table->data())[it.second] = entries->second;
+            }
+            else
+            {
+                // the insertion was rolled back
+                table->data()->erase(it.second);
+            }
+            if (m_trackAccess)
+            {
+                m_writeSet.insert(it);
+            }
+        }
+    };
+    apply(true);
+    apply(false);
+}
+
+Entries::Ptr MemoryTableFactory::cachedEntries(const string& _tableName, const string& _key)
+{
+    auto table = m_name2Table.find(_tableName);
+    if (table == m_name2Table.end())
+    {
+        return nullptr;
+    }
+    auto data = table->second->data();
+    auto entries = data->find(_key);
+    if (entries == data->end())
+    {
+        return nullptr;
+    }
+    return entries->second;
+}
+
 storage::TableInfo::Ptr MemoryTableFactory::getSysTableInfo(const std::string& tableName)
 {
     auto tableInfo = make_shared<storage::TableInfo>();
@@ -281,5 +372,10 @@ storage::TableInfo::Ptr MemoryTableFactory::getSysTableInfo(const std::string& t
         tableInfo->key = "key";
         tableInfo->fields = std::vector<std::string>{"value"};
     }
+    else if (tableName == SYS_HASH_2_CODE)
+    {
+        tableInfo->key = "hash";
+        tableInfo->fields = std::vector<std::string>{"value"};
+    }
     return tableInfo;
 }
@@ -22,6 +22,7 @@
 
 #include "Storage.h"
 #include "Table.h"
+#include <set>
 
 namespace dev
 {
@@ -35,6 +36,8 @@ class MemoryTableFactory : public StateDBFactory
 {
 public:
     typedef std::shared_ptr<MemoryTableFactory> Ptr;
+    /// (table name, key) pairs accessed through the tables of the factory
+    typedef std::set<std::pair<std::string, std::string>> AccessSet;
     MemoryTableFactory();
     virtual ~MemoryTableFactory() {}
 
@@ -53,6 +56,25 @@ public:
     void rollback(size_t _savepoint);
     void commit();
     void commitDB(h256 const& _blockHash, int64_t _blockNumber);
+    /// drop the opened tables, the changes and the state storage, so the factory can be reused
+    void reset();
+    /// @returns the data of the opened tables having dirty entries, which commitDB commits
+    std::vector<TableData::Ptr> dirtyTables();
+
+    /// record the keys loaded from the state storage and the keys written, used to detect the
+    /// conflicts of speculatively executed transactions
+    void setTrackAccess(bool _trackAccess) { m_trackAccess = _trackAccess; }
+    AccessSet const& readSet() const { return m_readSet; }
+    AccessSet const& writeSet() const { return m_writeSet; }
+    void clearAccessSet();
+    /// the numbers of the operations on the tables since the factory is created
+    TableAccessStats const& accessStats() const { return *m_accessStats; }
+    /// copy the entries of the keys written in _other, which must be executed on the same
+    /// state without reading any key written to this factory since then
+    void applyWrites(MemoryTableFactory& _other);
+    /// @returns the entries of the key loaded into the opened table, or nullptr if they aren't
+    /// loaded. Doesn't load anything, so it's safe to call concurrently while nothing is written
+    Entries::Ptr cachedEntries(const std::string& _tableName, const std::string& _key);
 
 private:
     storage::TableInfo::Ptr getSysTableInfo(const std::string& tableName);
@@ -63,6 +85,10 @@ private:
     std::vector<Change> m_changeLog;
     h256 m_hash;
     std::vector<std::string> m_sysTables;
+    bool m_trackAccess = false;
+    AccessSet m_readSet;
+    AccessSet m_writeSet;
+    TableAccessStats::Ptr m_accessStats = std::make_shared<TableAccessStats>();
 };
 
 }  // namespace storage
@@ -0,0 +1,59 @@
+/*
+    This file is part of FISCO-BCOS.
+
+    FISCO-BCOS is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FISCO-BCOS is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file OverlayStorage.cpp
+ *  @record storage reading the uncommitted data of a MemoryTableFactory
+ */
+#include "OverlayStorage.h"
+#include "StorageException.h"
+#include <libdevcore/easylog.h>
+
+using namespace dev;
+using namespace dev::storage;
+
+Entries::Ptr OverlayStorage::select(
+    h256 hash, int num, const std::string& table, const std::string& key)
+{
+    {
+        ReadGuard l(x_memoryTableFactory);
+        auto entries = m_memoryTableFactory->cachedEntries(table, key);
+        if (entries)
+        {
+            // keep the dirty flags and deleted entries, the entries replace the original ones
+            // when the writes are applied
+            Entries::Ptr copy = std::make_shared<Entries>();
+            for (size_t i = 0; i < entries->size(); ++i)
+            {
+                copy->addEntry(std::make_shared<Entry>(*entries->get(i)));
+            }
+            copy->setDirty(entries->dirty());
+            return copy;
+        }
+    }
+    return m_memoryTableFactory->stateStorage()->select(hash, num, table, key);
+}
+
+size_t OverlayStorage::commit(h256, int64_t, const std::vector<TableData::Ptr>&, h256)
+{
+    STORAGE_LOG(ERROR) << "OverlayStorage can't be committed";
+    BOOST_THROW_EXCEPTION(StorageException(-1, "OverlayStorage can't be committed"));
+}
+
+void OverlayStorage::applyWrites(MemoryTableFactory& _memoryTableFactory)
+{
+    WriteGuard l(x_memoryTableFactory);
+    m_memoryTableFactory->applyWrites(_memoryTableFactory);
+}
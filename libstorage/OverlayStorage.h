@@ -0,0 +1,63 @@
+/*
+    This file is part of FISCO-BCOS.
+
+    FISCO-BCOS is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FISCO-BCOS is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file OverlayStorage.h
+ *  @record storage reading the uncommitted data of a MemoryTableFactory
+ */
+#pragma once
+
+#include "MemoryTableFactory.h"
+#include "Storage.h"
+#include <libdevcore/Guards.h>
+
+namespace dev
+{
+namespace storage
+{
+/**
+ * @brief Storage of the MemoryTableFactory of one transaction, reading the data written to the
+ * MemoryTableFactory of the block first and its state storage second. The entries are copied, so
+ * the transactions can be executed concurrently; their writes must be applied through the
+ * OverlayStorage.
+ */
+class OverlayStorage : public Storage
+{
+public:
+    typedef std::shared_ptr<OverlayStorage> Ptr;
+
+    OverlayStorage(MemoryTableFactory::Ptr _memoryTableFactory)
+      : m_memoryTableFactory(_memoryTableFactory)
+    {}
+
+    virtual ~OverlayStorage(){};
+
+    virtual Entries::Ptr select(
+        h256 hash, int num, const std::string& table, const std::string& key) override;
+    /// the data is applied to the MemoryTableFactory of the block instead
+    virtual size_t commit(
+        h256 hash, int64_t num, const std::vector<TableData::Ptr>& datas, h256 blockHash) override;
+    virtual bool onlyDirty() override { return false; }
+
+    void applyWrites(MemoryTableFactory& _memoryTableFactory);
+
+private:
+    MemoryTableFactory::Ptr m_memoryTableFactory;
+    SharedMutex x_memoryTableFactory;
+};
+
+}  // namespace storage
+
+}  // namespace dev
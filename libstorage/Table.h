@@ -139,6 +139,16 @@ struct Change
     {}
 };
 
+/// numbers of the operations on the tables of a factory
+struct TableAccessStats
+{
+    typedef std::shared_ptr<TableAccessStats> Ptr;
+    uint64_t selects = 0;
+    /// the keys loaded from the state storage, which weren't cached by their table
+    uint64_t loads = 0;
+    uint64_t writes = 0;
+};
+
 // Construction of transaction execution
 class Table : public std::enable_shared_from_this<Table>
 {
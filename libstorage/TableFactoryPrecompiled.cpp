@@ -60,7 +60,7 @@ bytes TableFactoryPrecompiled::call(std::shared_ptr<ExecutiveContext> context, b
 
         STORAGE_LOG(DEBUG) << "DBFactory open table:" << tableName;
         Address address;
-        auto table = m_memoryTableFactory->openTable(tableName);
+        auto table = memoryTableFactory(context)->openTable(tableName);
         if (table)
         {
             TablePrecompiled::Ptr tablePrecompiled = make_shared<TablePrecompiled>();
@@ -87,7 +87,7 @@ bytes TableFactoryPrecompiled::call(std::shared_ptr<ExecutiveContext> context, b
         for (auto& str : fieldNameList)
             boost::trim(str);
         valueFiled = boost::join(fieldNameList, ",");
-        auto table = m_memoryTableFactory->createTable(tableName, keyField, valueFiled);
+        auto table = memoryTableFactory(context)->createTable(tableName, keyField, valueFiled);
         // tableName already exist
         unsigned errorCode = 0;
         if (!table == 0u)
@@ -107,6 +107,43 @@ bytes TableFactoryPrecompiled::call(std::shared_ptr<ExecutiveContext> context, b
     return out;
 }
 
+ConflictKeys TableFactoryPrecompiled::conflictKeys(bytesConstRef param)
+{
+    // the returned table handle may access any key of the table
+    ConflictKeys keys;
+    uint32_t func = getParamFunc(param);
+    bytesConstRef data = getParamData(param);
+    dev::eth::ContractABI abi;
+    string tableName;
+    switch (func)
+    {
+    case 0xc184e0ff:  // openDB(string)
+    case 0xf23f63c9:  // openTable(string)
+        abi.abiOut(data, tableName);
+        keys.emplace_back(tableName, "");
+        break;
+    case 0x56004b6a:
+    {  // createTable(string,string,string)
+        string keyField;
+        string valueFiled;
+        abi.abiOut(data, tableName, keyField, valueFiled);
+        keys.emplace_back(tableName, "");
+        break;
+    }
+    default:
+        break;
+    }
+    return keys;
+}
+
+dev::storage::MemoryTableFactory::Ptr TableFactoryPrecompiled::memoryTableFactory(
+    std::shared_ptr<ExecutiveContext> context)
+{
+    if (m_memoryTableFactory)
+        return m_memoryTableFactory;
+    return context->getMemoryTableFactory();
+}
+
 h256 TableFactoryPrecompiled::hash()
 {
     return m_memoryTableFactory->hash();
@@ -54,6 +54,10 @@ public:
 
     virtual bytes call(std::shared_ptr<ExecutiveContext> context, bytesConstRef param);
 
+    virtual ConflictKeys conflictKeys(bytesConstRef param);
+
+    /// without a table factory set, the tables are opened in the factory of the calling context,
+    /// so the instance can be shared by the contexts
     void setMemoryTableFactory(dev::storage::MemoryTableFactory::Ptr memoryTableFactory)
     {
         m_memoryTableFactory = memoryTableFactory;
@@ -64,6 +68,9 @@ public:
     h256 hash();
 
 private:
+    dev::storage::MemoryTableFactory::Ptr memoryTableFactory(
+        std::shared_ptr<ExecutiveContext> context);
+
     dev::storage::MemoryTableFactory::Ptr m_memoryTableFactory;
 };
 
@@ -24,7 +24,7 @@
 #include "EntryPrecompiled.h"
 #include "Table.h"
 #include <libdevcore/easylog.h>
-#include <libethcore/ABI.h>
+#include <libethcore/ABICodec.h>
 
 using namespace dev;
 using namespace dev::blockverifier;
@@ -44,44 +44,42 @@ bytes TablePrecompiled::call(std::shared_ptr<ExecutiveContext> context, bytesCon
 
     STORAGE_LOG(DEBUG) << "func:" << std::hex << func;
 
-    dev::eth::ContractABI abi;
-
     bytes out;
 
     switch (func)
     {
     case 0xe8434e39:
     {  // select(string,address)
-        std::string key;
+        dev::eth::stringConstRef key;
         Address conditionAddress;
-        abi.abiOut(data, key, conditionAddress);
+        dev::eth::ABICodec::decode(data, key, conditionAddress);
 
         ConditionPrecompiled::Ptr conditionPrecompiled =
             std::dynamic_pointer_cast<ConditionPrecompiled>(
                 context->getPrecompiled(conditionAddress));
         auto condition = conditionPrecompiled->getCondition();
 
-        auto entries = m_table->select(key, condition);
+        auto entries = m_table->select(key.toString(), condition);
         auto entriesPrecompiled = std::make_shared<EntriesPrecompiled>();
         entriesPrecompiled->setEntries(entries);
 
         auto newAddress = context->registerPrecompiled(entriesPrecompiled);
-        out = abi.abiIn("", newAddress);
+        dev::eth::ABICodec::encode(out, newAddress);
 
         break;
     }
     case 0x31afac36:
     {  // insert(string,address)
-        std::string key;
+        dev::eth::stringConstRef key;
         Address entryAddress;
-        abi.abiOut(data, key, entryAddress);
+        dev::eth::ABICodec::decode(data, key, entryAddress);
 
         EntryPrecompiled::Ptr entryPrecompiled =
             std::dynamic_pointer_cast<EntryPrecompiled>(context->getPrecompiled(entryAddress));
         auto entry = entryPrecompiled->getEntry();
 
-        size_t count = m_table->insert(key, entry);
-        out = abi.abiIn("", u256(count));
+        size_t count = m_table->insert(key.toString(), entry);
+        dev::eth::ABICodec::encode(out, u256(count));
 
         break;
     }
@@ -92,7 +90,7 @@ bytes TablePrecompiled::call(std::shared_ptr<ExecutiveContext> context, bytesCon
         conditionPrecompiled->setCondition(condition);
 
         auto newAddress = context->registerPrecompiled(conditionPrecompiled);
-        out = abi.abiIn("", newAddress);
+        dev::eth::ABICodec::encode(out, newAddress);
 
         break;
     }
@@ -103,32 +101,32 @@ bytes TablePrecompiled::call(std::shared_ptr<ExecutiveContext> context, bytesCon
         entryPrecompiled->setEntry(entry);
 
         auto newAddress = context->registerPrecompiled(entryPrecompiled);
-        out = abi.abiIn("", newAddress);
+        dev::eth::ABICodec::encode(out, newAddress);
 
         break;
     }
     case 0x28bb2117:
     {  // remove(string,address)
-        std::string key;
+        dev::eth::stringConstRef key;
         Address conditionAddress;
-        abi.abiOut(data, key, conditionAddress);
+        dev::eth::ABICodec::decode(data, key, conditionAddress);
 
         ConditionPrecompiled::Ptr conditionPrecompiled =
             std::dynamic_pointer_cast<ConditionPrecompiled>(
                 context->getPrecompiled(conditionAddress));
         auto condition = conditionPrecompiled->getCondition();
 
-        size_t count = m_table->remove(key, condition);
-        out = abi.abiIn("", u256(count));
+        size_t count = m_table->remove(key.toString(), condition);
+        dev::eth::ABICodec::encode(out, u256(count));
 
         break;
     }
     case 0xbf2b70a1:
     {  // update(string,address,address)
-        std::string key;
+        dev::eth::stringConstRef key;
         Address entryAddress;
         Address conditionAddress;
-        abi.abiOut(data, key, entryAddress, conditionAddress);
+        dev::eth::ABICodec::decode(data, key, entryAddress, conditionAddress);
 
         EntryPrecompiled::Ptr entryPrecompiled =
             std::dynamic_pointer_cast<EntryPrecompiled>(context->getPrecompiled(entryAddress));
@@ -138,8 +136,105 @@ bytes TablePrecompiled::call(std::shared_ptr<ExecutiveContext> context, bytesCon
         auto entry = entryPrecompiled->getEntry();
         auto condition = conditionPrecompiled->getCondition();
 
-        size_t count = m_table->update(key, entry, condition);
-        out = abi.abiIn("", u256(count));
+        size_t count = m_table->update(key.toString(), entry, condition);
+        dev::eth::ABICodec::encode(out, u256(count));
+
+        break;
+    }
+    case 0x889912bf:
+    {  // insertBatch(string[],address[])
+        std::vector<dev::eth::stringConstRef> keys;
+        std::vector<Address> entryAddresses;
+        dev::eth::ABICodec::decode(data, keys, entryAddresses);
+        if (keys.size() != entryAddresses.size())
+        {
+            STORAGE_LOG(ERROR) << "insertBatch keys:" << keys.size()
+                               << " entries:" << entryAddresses.size();
+            break;
+        }
+
+        size_t count = 0;
+        for (size_t i = 0; i < keys.size(); ++i)
+        {
+            EntryPrecompiled::Ptr entryPrecompiled = std::dynamic_pointer_cast<EntryPrecompiled>(
+                context->getPrecompiled(entryAddresses[i]));
+            count += m_table->insert(keys[i].toString(), entryPrecompiled->getEntry());
+        }
+        dev::eth::ABICodec::encode(out, u256(count));
+
+        break;
+    }
+    case 0xca2485d3:
+    {  // selectBatch(string[],address)
+        std::vector<dev::eth::stringConstRef> keys;
+        Address conditionAddress;
+        dev::eth::ABICodec::decode(data, keys, conditionAddress);
+
+        ConditionPrecompiled::Ptr conditionPrecompiled =
+            std::dynamic_pointer_cast<ConditionPrecompiled>(
+                context->getPrecompiled(conditionAddress));
+        auto condition = conditionPrecompiled->getCondition();
+
+        // the entries of the keys in their order, in one entries precompiled
+        auto entries = std::make_shared<storage::Entries>();
+        for (auto const& key : keys)
+        {
+            auto keyEntries = m_table->select(key.toString(), condition);
+            for (size_t i = 0; i < keyEntries->size(); ++i)
+                entries->addEntry(keyEntries->get(i));
+        }
+        auto entriesPrecompiled = std::make_shared<EntriesPrecompiled>();
+        entriesPrecompiled->setEntries(entries);
+
+        auto newAddress = context->registerPrecompiled(entriesPrecompiled);
+        dev::eth::ABICodec::encode(out, newAddress);
+
+        break;
+    }
+    case 0xbc4f2c79:
+    {  // updateBatch(string[],address[],address)
+        std::vector<dev::eth::stringConstRef> keys;
+        std::vector<Address> entryAddresses;
+        Address conditionAddress;
+        dev::eth::ABICodec::decode(data, keys, entryAddresses, conditionAddress);
+        if (keys.size() != entryAddresses.size())
+        {
+            STORAGE_LOG(ERROR) << "updateBatch keys:" << keys.size()
+                               << " entries:" << entryAddresses.size();
+            break;
+        }
+
+        ConditionPrecompiled::Ptr conditionPrecompiled =
+            std::dynamic_pointer_cast<ConditionPrecompiled>(
+                context->getPrecompiled(conditionAddress));
+        auto condition = conditionPrecompiled->getCondition();
+
+        size_t count = 0;
+        for (size_t i = 0; i < keys.size(); ++i)
+        {
+            EntryPrecompiled::Ptr entryPrecompiled = std::dynamic_pointer_cast<EntryPrecompiled>(
+                context->getPrecompiled(entryAddresses[i]));
+            count += m_table->update(keys[i].toString(), entryPrecompiled->getEntry(), condition);
+        }
+        dev::eth::ABICodec::encode(out, u256(count));
+
+        break;
+    }
+    case 0xa114571b:
+    {  // removeBatch(string[],address)
+        std::vector<dev::eth::stringConstRef> keys;
+        Address conditionAddress;
+        dev::eth::ABICodec::decode(data, keys, conditionAddress);
+
+        ConditionPrecompiled::Ptr conditionPrecompiled =
+            std::dynamic_pointer_cast<ConditionPrecompiled>(
+                context->getPrecompiled(conditionAddress));
+        auto condition = conditionPrecompiled->getCondition();
+
+        size_t count = 0;
+        for (auto const& key : keys)
+            count += m_table->remove(key.toString(), condition);
+        dev::eth::ABICodec::encode(out, u256(count));
 
         break;
     }
@@ -36,6 +36,10 @@ contract DB {
     function remove(string, Condition) public returns(int);
     function newEntry() public constant returns(Entry);
     function newCondition() public constant returns(Condition);
+    function insertBatch(string[], Entry[]) public returns(int);
+    function selectBatch(string[], Condition) public constant returns(Entries);
+    function updateBatch(string[], Entry[], Condition) public returns(int);
+    function removeBatch(string[], Condition) public returns(int);
 }
 {
     "31afac36": "insert(string,address)",
@@ -43,7 +47,11 @@ contract DB {
     "13db9346": "newEntry()",
     "28bb2117": "remove(string,address)",
     "e8434e39": "select(string,address)",
-    "bf2b70a1": "update(string,address,address)"
+    "bf2b70a1": "update(string,address,address)",
+    "889912bf": "insertBatch(string[],address[])",
+    "ca2485d3": "selectBatch(string[],address)",
+    "bc4f2c79": "updateBatch(string[],address[],address)",
+    "a114571b": "removeBatch(string[],address)"
 }
 #endif
 
@@ -0,0 +1,106 @@
+/*
+    @CopyRight:
+    This file is part of FISCO-BCOS.
+
+    FISCO-BCOS is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FISCO-BCOS is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @brief process-wide contract code cache for StorageState
+ *
+ * @file CodeCache.h
+ */
+
+#pragma once
+
+#include <libdevcore/Common.h>
+#include <libdevcore/FixedHash.h>
+#include <libdevcore/Guards.h>
+#include <list>
+#include <memory>
+#include <unordered_map>
+
+namespace dev
+{
+namespace storagestate
+{
+/**
+ * @brief Thread-safe LRU cache from code hash to decoded contract code.
+ * Code is content addressed, so an entry never becomes stale and is shared by the StorageState of
+ * every block. The least recently used code is evicted once the total code size exceeds the limit.
+ */
+class CodeCache
+{
+public:
+    typedef std::shared_ptr<bytes const> CodePtr;
+
+    /// @returns nullptr if the code isn't cached
+    CodePtr get(h256 const& _hash)
+    {
+        Guard g(x_cache);
+        auto it = m_cache.find(_hash);
+        if (it == m_cache.end())
+            return nullptr;
+        m_lru.splice(m_lru.begin(), m_lru, it->second);
+        return it->second->second;
+    }
+
+    void store(h256 const& _hash, CodePtr _code)
+    {
+        Guard g(x_cache);
+        if (m_cache.count(_hash))
+            return;
+        m_lru.emplace_front(_hash, _code);
+        m_cache[_hash] = m_lru.begin();
+        m_size += _code->size();
+        while (m_size > m_maxSize && m_lru.size() > 1)
+        {
+            m_size -= m_lru.back().second->size();
+            m_cache.erase(m_lru.back().first);
+            m_lru.pop_back();
+        }
+    }
+
+    void setMaxSize(size_t _maxSize)
+    {
+        Guard g(x_cache);
+        m_maxSize = _maxSize;
+    }
+
+    void clear()
+    {
+        Guard g(x_cache);
+        m_lru.clear();
+        m_cache.clear();
+        m_size = 0;
+    }
+
+    static CodeCache& instance()
+    {
+        static CodeCache cache;
+        return cache;
+    }
+
+private:
+    typedef std::list<std::pair<h256, CodePtr>> LRUList;
+
+    static const size_t c_defaultMaxSize = 64 * 1024 * 1024;
+    Mutex x_cache;
+    LRUList m_lru;
+    std::unordered_map<h256, LRUList::iterator> m_cache;
+    size_t m_size = 0;
+    size_t m_maxSize = c_defaultMaxSize;
+};
+
+}  // namespace storagestate
+}  // namespace dev
@@ -26,6 +26,7 @@
 #include "StorageState.h"
 #include "libdevcore/SHA3.h"
 #include "libethcore/Exceptions.h"
+#include "libstorage/Common.h"
 #include "libstorage/MemoryTableFactory.h"
 
 using namespace dev;
@@ -34,6 +35,17 @@ using namespace dev::storagestate;
 using namespace dev::storage;
 using namespace dev::executive;
 
+namespace
+{
+/// update a field row of an account of the chains before version 1
+void updateAccountRow(Table::Ptr const& _table, const char* _key, std::string const& _value)
+{
+    auto entry = _table->newEntry();
+    entry->setField(STORAGE_VALUE, _value);
+    _table->update(_key, entry, _table->newCondition());
+}
+}  // namespace
+
 bool StorageState::addressInUse(Address const& _address) const
 {
     auto table = getTable(_address);
@@ -46,11 +58,11 @@ bool StorageState::addressInUse(Address const& _address) const
 
 bool StorageState::accountNonemptyAndExisting(Address const& _address) const
 {
-    auto table = getTable(_address);
-    if (table)
+    auto header = accountHeader(_address);
+    if (header)
     {
-        if (balance(_address) > u256(0) || codeHash(_address) != EmptySHA3 ||
-            getNonce(_address) != m_accountStartNonce)
+        if (header->balance > u256(0) || header->codeHash != EmptySHA3 ||
+            header->nonce != m_accountStartNonce)
             return true;
     }
     return false;
@@ -58,48 +70,32 @@ bool StorageState::accountNonemptyAndExisting(Address const& _address) const
 
 bool StorageState::addressHasCode(Address const& _address) const
 {
-    auto table = getTable(_address);
-    if (table)
+    auto header = accountHeader(_address);
+    if (header)
     {
-        auto entries = table->select(ACCOUNT_CODE_HASH, table->newCondition());
-        if (entries->size() != 0u)
-        {
-            auto codeHash = h256(fromHex(entries->get(0)->getField(STORAGE_VALUE)));
-            return codeHash != EmptySHA3;
-        }
+        return header->codeHash != EmptySHA3;
     }
     return false;
 }
 
 u256 StorageState::balance(Address const& _address) const
 {
-    auto table = getTable(_address);
-    if (table)
+    auto header = accountHeader(_address);
+    if (header)
     {
-        auto entries = table->select(ACCOUNT_BALANCE, table->newCondition());
-        if (entries->size() != 0u)
-        {
-            return u256(entries->get(0)->getField(STORAGE_VALUE));
-        }
+        return header->balance;
     }
     return 0;
 }
 
 void StorageState::addBalance(Address const& _address, u256 const& _amount)
 {
-    auto table = getTable(_address);
-    if (table)
+    auto header = accountHeader(_address);
+    if (header)
     {
-        auto entries = table->select(ACCOUNT_BALANCE, table->newCondition());
-        if (entries->size() != 0u)
-        {
-            auto entry = entries->get(0);
-            auto balance = u256(entry->getField(STORAGE_VALUE));
-            balance += _amount;
-            entry = table->newEntry();
-            entry->setField(STORAGE_VALUE, balance.str());
-            table->update(ACCOUNT_BALANCE, entry, table->newCondition());
-        }
+        auto newHeader = *header;
+        newHeader.balance += _amount;
+        setAccountHeader(_address, newHeader, BalanceField);
     }
     else
     {
@@ -109,21 +105,14 @@ void StorageState::addBalance(Address const& _address, u256 const& _amount)
 
 void StorageState::subBalance(Address const& _address, u256 const& _amount)
 {
-    auto table = getTable(_address);
-    if (table)
+    auto header = accountHeader(_address);
+    if (header)
     {
-        auto entries = table->select(ACCOUNT_BALANCE, table->newCondition());
-        if (entries->size() != 0u)
-        {
-            auto entry = entries->get(0);
-            auto balance = u256(entry->getField(STORAGE_VALUE));
-            if (balance < _amount)
-                BOOST_THROW_EXCEPTION(NotEnoughCash());
-            balance -= _amount;
-            entry = table->newEntry();
-            entry->setField(STORAGE_VALUE, balance.str());
-            table->update(ACCOUNT_BALANCE, entry, table->newCondition());
-        }
+        if (header->balance < _amount)
+            BOOST_THROW_EXCEPTION(NotEnoughCash());
+        auto newHeader = *header;
+        newHeader.balance -= _amount;
+        setAccountHeader(_address, newHeader, BalanceField);
     }
     else
     {
@@ -133,19 +122,12 @@ void StorageState::subBalance(Address const& _address, u256 const& _amount)
 
 void StorageState::setBalance(Address const& _address, u256 const& _amount)
 {
-    auto table = getTable(_address);
-    if (table)
+    auto header = accountHeader(_address);
+    if (header)
     {
-        auto entries = table->select(ACCOUNT_BALANCE, table->newCondition());
-        if (entries->size() != 0u)
-        {
-            auto entry = entries->get(0);
-            auto balance = u256(entry->getField(STORAGE_VALUE));
-            balance = _amount;
-            entry = table->newEntry();
-            entry->setField(STORAGE_VALUE, balance.str());
-            table->update(ACCOUNT_BALANCE, entry, table->newCondition());
-        }
+        auto newHeader = *header;
+        newHeader.balance = _amount;
+        setAccountHeader(_address, newHeader, BalanceField);
     }
     else
     {
@@ -171,14 +153,22 @@ h256 StorageState::storageRoot(Address const& _address) const
 
 u256 StorageState::storage(Address const& _address, u256 const& _key) const
 {
+    auto slotKey = std::make_pair(_address, _key);
+    auto it = m_slots.find(slotKey);
+    if (it != m_slots.end())
+        return it->second.value;
     auto table = getTable(_address);
     if (table)
     {
+        StorageSlot slot{u256(), false};
         auto entries = table->select(_key.str(), table->newCondition());
         if (entries->size() != 0u)
         {
-            return u256(entries->get(0)->getField(STORAGE_VALUE));
+            slot.value = u256(entries->get(0)->getField(STORAGE_VALUE));
+            slot.exists = true;
         }
+        m_slots.emplace(slotKey, slot);
+        return slot.value;
     }
     return u256();
 }
@@ -188,21 +178,22 @@ void StorageState::setStorage(Address const& _address, u256 const& _location, u2
     auto table = getTable(_address);
     if (table)
     {
-        auto entries = table->select(_location.str(), table->newCondition());
-        if (entries->size() == 0u)
-        {
-            auto entry = table->newEntry();
-            entry->setField(STORAGE_KEY, _location.str());
-            entry->setField(STORAGE_VALUE, _value.str());
-            table->insert(_location.str(), entry);
-        }
+        auto slotKey = std::make_pair(_address, _location);
+        auto it = m_slots.find(slotKey);
+        bool exists;
+        if (it != m_slots.end())
+            exists = it->second.exists;
         else
-        {
-            auto entry = table->newEntry();
-            entry->setField(STORAGE_KEY, _location.str());
-            entry->setField(STORAGE_VALUE, _value.str());
-            table->update(_location.str(), entry, table->newCondition());
-        }
+            exists = table->select(_location.str(), table->newCondition())->size() != 0u;
+        auto key = _location.str();
+        auto entry = table->newEntry();
+        entry->setField(STORAGE_KEY, key);
+        entry->setField(STORAGE_VALUE, _value.str());
+        if (exists)
+            table->update(key, entry, table->newCondition());
+        else
+            table->insert(key, entry);
+        m_slots[slotKey] = StorageSlot{_value, true};
     }
 }
 
@@ -210,39 +201,47 @@ void StorageState::clearStorage(Address const& _address) {}
 
 void StorageState::setCode(Address const& _address, bytes&& _code)
 {
-    auto table = getTable(_address);
-    if (table)
+    auto code = std::make_shared<bytes const>(std::move(_code));
+    auto header = accountHeader(_address);
+    if (header)
     {
-        auto entry = table->newEntry();
-        entry->setField(STORAGE_VALUE, toHex(_code));
-        table->update(ACCOUNT_CODE, entry, table->newCondition());
-        entry = table->newEntry();
-        entry->setField(STORAGE_VALUE, toHex(sha3(_code)));
-        table->update(ACCOUNT_CODE_HASH, entry, table->newCondition());
+        auto newHeader = *header;
+        newHeader.codeHash = sha3(*code);
+        if (m_chainVersion == 0)
+            updateAccountRow(getTable(_address), ACCOUNT_CODE, toHex(*code));
+        if (newHeader.codeHash != EmptySHA3)
+        {
+            // code is content addressed, contracts deployed with the same code share one row
+            auto table =
+                m_chainVersion > 0 ? m_memoryTableFactory->openTable(SYS_HASH_2_CODE) : nullptr;
+            if (table)
+            {
+                auto entries = table->select(newHeader.codeHash.hex(), table->newCondition());
+                if (entries->size() == 0u)
+                {
+                    auto entry = table->newEntry();
+                    entry->setField("hash", newHeader.codeHash.hex());
+                    entry->setField(SYS_VALUE, toHex(*code));
+                    table->insert(newHeader.codeHash.hex(), entry);
+                }
+            }
+            CodeCache::instance().store(newHeader.codeHash, code);
+        }
+        setAccountHeader(_address, newHeader, CodeHashField);
     }
-    m_cache[_address] = _code;
+    m_cache[_address] = code;
 }
 
 void StorageState::kill(Address _address)
 {
-    auto table = getTable(_address);
-    if (table)
+    auto header = accountHeader(_address);
+    if (header)
     {
-        auto entry = table->newEntry();
-        entry->setField(STORAGE_VALUE, m_accountStartNonce.str());
-        table->update(ACCOUNT_NONCE, entry, table->newCondition());
-        entry = table->newEntry();
-        entry->setField(STORAGE_VALUE, u256(0).str());
-        table->update(ACCOUNT_BALANCE, entry, table->newCondition());
-        entry = table->newEntry();
-        entry->setField(STORAGE_VALUE, "");
-        table->update(ACCOUNT_CODE, entry, table->newCondition());
-        entry = table->newEntry();
-        entry->setField(STORAGE_VALUE, toHex(EmptySHA3));
-        table->update(ACCOUNT_CODE_HASH, entry, table->newCondition());
-        entry = table->newEntry();
-        entry->setField(STORAGE_VALUE, "false");
-        table->update(ACCOUNT_ALIVE, entry, table->newCondition());
+        AccountHeader newHeader(m_accountStartNonce, u256(0));
+        newHeader.alive = false;
+        if (m_chainVersion == 0)
+            updateAccountRow(getTable(_address), ACCOUNT_CODE, "");
+        setAccountHeader(_address, newHeader, AllFields);
     }
     clear();
 }
@@ -251,32 +250,46 @@ bytes const& StorageState::code(Address const& _address) const
 {
     auto it = m_cache.find(_address);
     if (it != m_cache.end())
-        return it->second;
-    if (codeHash(_address) == EmptySHA3)
+        return *it->second;
+    auto hash = codeHash(_address);
+    if (hash == EmptySHA3)
         return NullBytes;
-    auto table = getTable(_address);
-    if (table)
+    auto code = CodeCache::instance().get(hash);
+    if (!code)
     {
-        auto entries = table->select(ACCOUNT_CODE, table->newCondition());
-        if (entries->size() != 0u)
+        auto table =
+            m_chainVersion > 0 ? m_memoryTableFactory->openTable(SYS_HASH_2_CODE) : nullptr;
+        if (table)
         {
-            m_cache[_address] = fromHex(entries->get(0)->getField(STORAGE_VALUE));
-            return m_cache[_address];
+            auto entries = table->select(hash.hex(), table->newCondition());
+            if (entries->size() != 0u)
+                code = std::make_shared<bytes const>(
+                    fromHex(entries->get(0)->getField(SYS_VALUE)));
         }
+        if (!code)
+        {
+            // the code deployed before the code table is kept in a row of the account
+            table = getTable(_address);
+            if (!table)
+                return NullBytes;
+            auto entries = table->select(ACCOUNT_CODE, table->newCondition());
+            if (entries->size() == 0u)
+                return NullBytes;
+            code =
+                std::make_shared<bytes const>(fromHex(entries->get(0)->getField(STORAGE_VALUE)));
+        }
+        CodeCache::instance().store(hash, code);
     }
-    return NullBytes;
+    m_cache[_address] = code;
+    return *code;
 }
 
 h256 StorageState::codeHash(Address const& _address) const
 {
-    auto table = getTable(_address);
-    if (table)
+    auto header = accountHeader(_address);
+    if (header)
     {
-        auto entries = table->select(ACCOUNT_CODE_HASH, table->newCondition());
-        if (entries->size() != 0u)
-        {
-            return h256(fromHex(entries->get(0)->getField(STORAGE_VALUE)));
-        }
+        return header->codeHash;
     }
     return EmptySHA3;
 }
@@ -293,19 +306,12 @@ void StorageState::createContract(Address const& _address)
 
 void StorageState::incNonce(Address const& _address)
 {
-    auto table = getTable(_address);
-    if (table)
+    auto header = accountHeader(_address);
+    if (header)
     {
-        auto entries = table->select(ACCOUNT_NONCE, table->newCondition());
-        if (entries->size() != 0u)
-        {
-            auto entry = entries->get(0);
-            auto nonce = u256(entry->getField(STORAGE_VALUE));
-            ++nonce;
-            entry = table->newEntry();
-            entry->setField(STORAGE_VALUE, nonce.str());
-            table->update(ACCOUNT_NONCE, entry, table->newCondition());
-        }
+        auto newHeader = *header;
+        ++newHeader.nonce;
+        setAccountHeader(_address, newHeader, NonceField);
     }
     else
         createAccount(_address, requireAccountStartNonce() + 1);
@@ -313,12 +319,12 @@ void StorageState::incNonce(Address const& _address)
 
 void StorageState::setNonce(Address const& _address, u256 const& _newNonce)
 {
-    auto table = getTable(_address);
-    if (table)
+    auto header = accountHeader(_address);
+    if (header)
     {
-        auto entry = table->newEntry();
-        entry->setField(STORAGE_VALUE, _newNonce.str());
-        table->update(ACCOUNT_NONCE, entry, table->newCondition());
+        auto newHeader = *header;
+        newHeader.nonce = _newNonce;
+        setAccountHeader(_address, newHeader, NonceField);
     }
     else
         createAccount(_address, _newNonce);
@@ -326,15 +332,10 @@ void StorageState::setNonce(Address const& _address, u256 const& _newNonce)
 
 u256 StorageState::getNonce(Address const& _address) const
 {
-    auto table = getTable(_address);
-    if (table)
+    auto header = accountHeader(_address);
+    if (header)
     {
-        auto entries = table->select(ACCOUNT_NONCE, table->newCondition());
-        if (entries->size() != 0u)
-        {
-            auto entry = entries->get(0);
-            return u256(entry->getField(STORAGE_VALUE));
-        }
+        return header->nonce;
     }
     return m_accountStartNonce;
 }
@@ -346,6 +347,7 @@ h256 StorageState::rootHash() const
 
 void StorageState::commit()
 {
+    clearTransactionCache();
     m_memoryTableFactory->commit();
 }
 
@@ -384,12 +386,22 @@ size_t StorageState::savepoint() const
 
 void StorageState::rollback(size_t _savepoint)
 {
+    m_cache.clear();
+    clearTransactionCache();
     m_memoryTableFactory->rollback(_savepoint);
 }
 
 void StorageState::clear()
 {
     m_cache.clear();
+    clearTransactionCache();
+}
+
+void StorageState::clearTransactionCache() const
+{
+    m_accountHeaders.clear();
+    m_slots.clear();
+    m_tables.clear();
 }
 
 void StorageState::createAccount(Address const& _address, u256 const& _nonce, u256 const& _amount)
@@ -397,30 +409,116 @@ void StorageState::createAccount(Address const& _address, u256 const& _nonce, u2
     std::string tableName("_contract_data_" + _address.hex() + "_");
     auto table = m_memoryTableFactory->createTable(tableName, STORAGE_KEY, STORAGE_VALUE);
 
-    auto entry = table->newEntry();
-    entry->setField(STORAGE_KEY, ACCOUNT_BALANCE);
-    entry->setField(STORAGE_VALUE, _amount.str());
-    table->insert(ACCOUNT_BALANCE, entry);
-    entry = table->newEntry();
-    entry->setField(STORAGE_KEY, ACCOUNT_CODE_HASH);
-    entry->setField(STORAGE_VALUE, toHex(EmptySHA3));
-    table->insert(ACCOUNT_CODE_HASH, entry);
-    entry = table->newEntry();
-    entry->setField(STORAGE_KEY, ACCOUNT_CODE);
-    entry->setField(STORAGE_VALUE, "");
-    table->insert(ACCOUNT_CODE, entry);
-    entry = table->newEntry();
-    entry->setField(STORAGE_KEY, ACCOUNT_NONCE);
-    entry->setField(STORAGE_VALUE, _nonce.str());
-    table->insert(ACCOUNT_NONCE, entry);
-    entry = table->newEntry();
-    entry->setField(STORAGE_KEY, ACCOUNT_ALIVE);
-    entry->setField(STORAGE_VALUE, "true");
-    table->insert(ACCOUNT_ALIVE, entry);
+    AccountHeader header(_nonce, _amount);
+    if (m_chainVersion == 0)
+    {
+        auto entry = table->newEntry();
+        entry->setField(STORAGE_KEY, ACCOUNT_BALANCE);
+        entry->setField(STORAGE_VALUE, _amount.str());
+        table->insert(ACCOUNT_BALANCE, entry);
+        entry = table->newEntry();
+        entry->setField(STORAGE_KEY, ACCOUNT_CODE_HASH);
+        entry->setField(STORAGE_VALUE, toHex(EmptySHA3));
+        table->insert(ACCOUNT_CODE_HASH, entry);
+        entry = table->newEntry();
+        entry->setField(STORAGE_KEY, ACCOUNT_CODE);
+        entry->setField(STORAGE_VALUE, "");
+        table->insert(ACCOUNT_CODE, entry);
+        entry = table->newEntry();
+        entry->setField(STORAGE_KEY, ACCOUNT_NONCE);
+        entry->setField(STORAGE_VALUE, _nonce.str());
+        table->insert(ACCOUNT_NONCE, entry);
+        entry = table->newEntry();
+        entry->setField(STORAGE_KEY, ACCOUNT_ALIVE);
+        entry->setField(STORAGE_VALUE, "true");
+        table->insert(ACCOUNT_ALIVE, entry);
+    }
+    else
+    {
+        auto entry = table->newEntry();
+        entry->setField(STORAGE_KEY, ACCOUNT_HEADER);
+        entry->setField(STORAGE_VALUE, toHex(header.rlp()));
+        table->insert(ACCOUNT_HEADER, entry);
+    }
+    m_accountHeaders[_address] = header;
+}
+
+AccountHeader const* StorageState::accountHeader(Address const& _address) const
+{
+    auto it = m_accountHeaders.find(_address);
+    if (it != m_accountHeaders.end())
+        return &it->second;
+    auto table = getTable(_address);
+    if (table)
+    {
+        if (m_chainVersion == 0)
+        {
+            // the account exists with its table, a missing field row reads as its default
+            AccountHeader header(m_accountStartNonce, u256());
+            auto entries = table->select(ACCOUNT_BALANCE, table->newCondition());
+            if (entries->size() != 0u)
+                header.balance = u256(entries->get(0)->getField(STORAGE_VALUE));
+            entries = table->select(ACCOUNT_NONCE, table->newCondition());
+            if (entries->size() != 0u)
+                header.nonce = u256(entries->get(0)->getField(STORAGE_VALUE));
+            entries = table->select(ACCOUNT_CODE_HASH, table->newCondition());
+            if (entries->size() != 0u)
+                header.codeHash = h256(fromHex(entries->get(0)->getField(STORAGE_VALUE)));
+            entries = table->select(ACCOUNT_ALIVE, table->newCondition());
+            if (entries->size() != 0u)
+                header.alive = entries->get(0)->getField(STORAGE_VALUE) != "false";
+            auto inserted = m_accountHeaders.emplace(_address, header);
+            return &inserted.first->second;
+        }
+        auto entries = table->select(ACCOUNT_HEADER, table->newCondition());
+        if (entries->size() != 0u)
+        {
+            auto value = fromHex(entries->get(0)->getField(STORAGE_VALUE));
+            auto inserted = m_accountHeaders.emplace(_address, AccountHeader(&value));
+            return &inserted.first->second;
+        }
+    }
+    return nullptr;
+}
+
+void StorageState::setAccountHeader(
+    Address const& _address, AccountHeader const& _header, unsigned _fields)
+{
+    auto table = getTable(_address);
+    if (table)
+    {
+        if (m_chainVersion == 0)
+        {
+            // only the rows of the changed fields are written, as the row hashes are part of the
+            // state root of the chain
+            if (_fields & NonceField)
+                updateAccountRow(table, ACCOUNT_NONCE, _header.nonce.str());
+            if (_fields & BalanceField)
+                updateAccountRow(table, ACCOUNT_BALANCE, _header.balance.str());
+            if (_fields & CodeHashField)
+                updateAccountRow(table, ACCOUNT_CODE_HASH, toHex(_header.codeHash));
+            if (_fields & AliveField)
+                updateAccountRow(table, ACCOUNT_ALIVE, _header.alive ? "true" : "false");
+        }
+        else
+        {
+            auto entry = table->newEntry();
+            entry->setField(STORAGE_VALUE, toHex(_header.rlp()));
+            table->update(ACCOUNT_HEADER, entry, table->newCondition());
+        }
+        m_accountHeaders[_address] = _header;
+    }
 }
 
 inline storage::Table::Ptr StorageState::getTable(Address const& _address) const
 {
+    auto it = m_tables.find(_address);
+    if (it != m_tables.end())
+        return it->second;
     std::string tableName("_contract_data_" + _address.hex() + "_");
-    return m_memoryTableFactory->openTable(tableName);
+    auto table = m_memoryTableFactory->openTable(tableName);
+    // the missing tables aren't cached, the account may be created later
+    if (table)
+        m_tables.emplace(_address, table);
+    return table;
 }
@@ -24,6 +24,9 @@
  */
 
 #pragma once
+#include "CodeCache.h"
+#include "libdevcore/RLP.h"
+#include "libdevcore/SHA3.h"
 #include "libexecutive/StateFace.h"
 
 namespace dev
@@ -37,11 +40,41 @@ namespace storagestate
 {
 const char* const STORAGE_KEY = "key";
 const char* const STORAGE_VALUE = "value";
+const char* const ACCOUNT_HEADER = "header";
 const char* const ACCOUNT_BALANCE = "balance";
 const char* const ACCOUNT_CODE_HASH = "codeHash";
 const char* const ACCOUNT_CODE = "code";
 const char* const ACCOUNT_NONCE = "nonce";
 const char* const ACCOUNT_ALIVE = "alive";
+
+/// Account fields which are stored together in the ACCOUNT_HEADER row since chain version 1, the
+/// code is stored once per code hash in _sys_hash_2_code_. The older chains keep a row per field.
+struct AccountHeader
+{
+    u256 balance;
+    u256 nonce;
+    h256 codeHash = EmptySHA3;
+    bool alive = true;
+
+    AccountHeader() = default;
+    AccountHeader(u256 const& _nonce, u256 const& _balance) : balance(_balance), nonce(_nonce) {}
+    explicit AccountHeader(bytesConstRef _rlp)
+    {
+        RLP r(_rlp);
+        balance = r[0].toInt<u256>();
+        nonce = r[1].toInt<u256>();
+        codeHash = r[2].toHash<h256>();
+        alive = r[3].toInt<unsigned>() != 0;
+    }
+
+    bytes rlp() const
+    {
+        RLPStream s(4);
+        s << balance << nonce << codeHash << (alive ? 1u : 0u);
+        return s.out();
+    }
+};
+
 class StorageState : public dev::executive::StateFace
 {
 public:
@@ -172,12 +205,54 @@ public:
     {
         m_memoryTableFactory = _memoryTableFactory;
     }
+    /// the account layout follows the version of the chain, 0 keeps the row per account field
+    void setChainVersion(unsigned _chainVersion) { m_chainVersion = _chainVersion; }
+    unsigned chainVersion() const { return m_chainVersion; }
 
 private:
-    mutable std::unordered_map<Address, bytes> m_cache;
+    /// fields of setAccountHeader whose rows are updated on the chains before version 1
+    enum AccountField : unsigned
+    {
+        BalanceField = 1,
+        NonceField = 2,
+        CodeHashField = 4,
+        AliveField = 8,
+        AllFields = 15
+    };
+
+    /// code of the accessed accounts, backed by the process-wide CodeCache
+    mutable std::unordered_map<Address, CodeCache::CodePtr> m_cache;
+    /// decoded account headers of the current transaction, cleared by commit() and rollback()
+    mutable std::unordered_map<Address, AccountHeader> m_accountHeaders;
+    /// a storage slot read or written by the current transaction
+    struct StorageSlot
+    {
+        u256 value;
+        /// whether the slot has a row in the table, to update it rather than insert it
+        bool exists;
+    };
+    typedef std::pair<Address, u256> SlotKey;
+    struct SlotKeyHash
+    {
+        size_t operator()(SlotKey const& _key) const
+        {
+            return std::hash<Address>()(_key.first) ^ static_cast<size_t>(_key.second);
+        }
+    };
+    /// storage slots of the current transaction, cleared with the account headers, the writes go
+    /// through to the tables so that their savepoints keep working
+    mutable std::unordered_map<SlotKey, StorageSlot, SlotKeyHash> m_slots;
+    /// tables of the existing accounts accessed by the current transaction
+    mutable std::unordered_map<Address, std::shared_ptr<dev::storage::Table>> m_tables;
     void createAccount(Address const& _address, u256 const& _nonce, u256 const& _amount = u256());
+    /// @returns nullptr if the account doesn't exist
+    AccountHeader const* accountHeader(Address const& _address) const;
+    void setAccountHeader(
+        Address const& _address, AccountHeader const& _header, unsigned _fields);
     std::shared_ptr<dev::storage::Table> getTable(Address const& _address) const;
+    void clearTransactionCache() const;
     u256 m_accountStartNonce;
+    unsigned m_chainVersion = 0;
     std::shared_ptr<dev::storage::MemoryTableFactory> m_memoryTableFactory;
 };
 }  // namespace storagestate
@@ -33,5 +33,6 @@ std::shared_ptr<StateFace> StorageStateFactory::getState(
 {
     auto storageState = make_shared<StorageState>(m_accountStartNonce);
     storageState->setMemoryTableFactory(_factory);
+    storageState->setChainVersion(m_chainVersion);
     return storageState;
 }
@@ -33,13 +33,17 @@ namespace storagestate
 class StorageStateFactory : public dev::executive::StateFactoryInterface
 {
 public:
-    StorageStateFactory(u256 const& _accountStartNonce) : m_accountStartNonce(_accountStartNonce) {}
+    StorageStateFactory(u256 const& _accountStartNonce, unsigned _chainVersion = 0)
+      : m_accountStartNonce(_accountStartNonce), m_chainVersion(_chainVersion)
+    {}
     virtual ~StorageStateFactory() {}
     std::shared_ptr<dev::executive::StateFace> getState(
         h256 const& _root, std::shared_ptr<dev::storage::MemoryTableFactory> _factory) override;
 
 private:
     u256 m_accountStartNonce;
+    /// the account layout of the created states
+    unsigned m_chainVersion;
 };
 }  // namespace storagestate
 }  // namespace dev
@@ -22,6 +22,8 @@
 
 #include "SyncMaster.h"
 #include <libblockchain/BlockChainInterface.h>
+#include <exception>
+#include <thread>
 
 using namespace std;
 using namespace dev;
@@ -372,16 +374,26 @@ bool SyncMaster::maintainDownloadingQueue()
 
     // pop block in sequence and ignore block which number is lower than currentNumber +1
     BlockPtr topBlock = bq.top();
+    // context executed while its parent was committed, and the hash of the block it was executed
+    // for. The block may be committed by consensus meanwhile, so the context is only reused for it
+    ExecutiveContext::Ptr exeCtx;
+    h256 exeHash;
     while (topBlock != nullptr && topBlock->header().number() <= (m_blockChain->number() + 1))
     {
         if (isNewBlock(topBlock))
         {
-            auto parentBlock = m_blockChain->getBlockByNumber(topBlock->blockHeader().number() - 1);
-            BlockInfo parentBlockInfo{parentBlock->header().hash(), parentBlock->header().number(),
-                parentBlock->header().stateRoot()};
-            ExecutiveContext::Ptr exeCtx =
-                m_blockVerifier->executeBlock(*topBlock, parentBlockInfo);
-            CommitResult ret = m_blockChain->commitBlock(*topBlock, exeCtx);
+            if (!exeCtx || exeHash != topBlock->headerHash())
+            {
+                auto parentBlock =
+                    m_blockChain->getBlockByNumber(topBlock->blockHeader().number() - 1);
+                BlockInfo parentBlockInfo{parentBlock->header().hash(),
+                    parentBlock->header().number(), parentBlock->header().stateRoot()};
+                exeCtx = m_blockVerifier->executeBlock(*topBlock, parentBlockInfo);
+            }
+            bq.pop();
+            BlockPtr nextBlock = bq.top();
+            ExecutiveContext::Ptr nextCtx;
+            CommitResult ret = commitAndExecuteNext(topBlock, exeCtx, nextBlock, nextCtx);
             if (ret == CommitResult::OK)
             {
                 m_txPool->dropBlockTrans(*topBlock);
@@ -398,6 +410,10 @@ bool SyncMaster::maintainDownloadingQueue()
                                << topBlock->transactions().size() << "/" << topBlock->headerHash()
                                << endl;
             }
+            exeCtx = nextCtx;
+            exeHash = nextCtx ? nextBlock->headerHash() : h256();
+            topBlock = nextBlock;
+            continue;
         }
         else
             SYNCLOG(TRACE)
@@ -405,6 +421,8 @@ bool SyncMaster::maintainDownloadingQueue()
                 << topBlock->header().number() << "/" << topBlock->transactions().size() << "/"
                 << topBlock->headerHash() << endl;
 
+        exeCtx = nullptr;
+        exeHash = h256();
         bq.pop();
         topBlock = bq.top();
     }
@@ -423,6 +441,55 @@ bool SyncMaster::maintainDownloadingQueue()
     return false;
 }
 
+CommitResult SyncMaster::commitAndExecuteNext(BlockPtr _block, ExecutiveContext::Ptr _context,
+    BlockPtr _nextBlock, ExecutiveContext::Ptr& o_nextContext)
+{
+    BlockInfo blockInfo{
+        _block->header().hash(), _block->header().number(), _block->header().stateRoot()};
+    dev::storage::ChainedStorage::Ptr snapshot;
+    if (_nextBlock != nullptr && _nextBlock->header().number() == blockInfo.number + 1 &&
+        _nextBlock->header().parentHash() == blockInfo.hash)
+        snapshot = m_blockVerifier->snapshotState(_context, blockInfo);
+    if (!snapshot)
+        return m_blockChain->commitBlock(*_block, _context);
+
+    CommitResult ret = CommitResult::ERROR_COMMITTING;
+    std::exception_ptr commitError;
+    std::thread commitThread([&]() {
+        try
+        {
+            ret = m_blockChain->commitBlock(*_block, _context);
+        }
+        catch (...)
+        {
+            commitError = std::current_exception();
+        }
+    });
+    try
+    {
+        o_nextContext = m_blockVerifier->executeChainedBlock(*_nextBlock, blockInfo, snapshot);
+    }
+    catch (std::exception& e)
+    {
+        // executed again on the committed block
+        SYNCLOG(DEBUG) << "[Download] [BlockSync] Execute on uncommitted parent failed "
+                          "[number/hash/error]: "
+                       << _nextBlock->header().number() << "/" << _nextBlock->headerHash() << "/"
+                       << e.what() << endl;
+        o_nextContext = nullptr;
+    }
+    commitThread.join();
+
+    if (commitError || ret != CommitResult::OK)
+    {
+        snapshot->abort();
+        o_nextContext = nullptr;
+    }
+    if (commitError)
+        std::rethrow_exception(commitError);
+    return ret;
+}
+
 void SyncMaster::maintainPeersConnection()
 {
     // Delete inactive peers
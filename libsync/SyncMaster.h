@@ -191,6 +191,11 @@ public:
 
 private:
     bool isNewBlock(BlockPtr _block);
+    /// commit _block, meanwhile execute _nextBlock on the state of _block if it is the child
+    /// @param o_nextContext the context of _nextBlock if it is committable after _block
+    dev::blockchain::CommitResult commitAndExecuteNext(BlockPtr _block,
+        dev::blockverifier::ExecutiveContext::Ptr _context, BlockPtr _nextBlock,
+        dev::blockverifier::ExecutiveContext::Ptr& o_nextContext);
     void printSyncInfo();
 };
 
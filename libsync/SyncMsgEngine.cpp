@@ -158,11 +158,37 @@ void SyncMsgEngine::onPeerTransactions(SyncMsgPacket const& _packet)
 
     size_t successCnt = 0;
 
+    Transactions txs;
+    txs.reserve(itemCount);
     for (unsigned i = 0; i < itemCount; ++i)
     {
-        Transaction tx;
-        tx.decode(rlps[i]);
+        try
+        {
+            Transaction tx;
+            tx.decode(rlps[i], CheckTransaction::Cheap);
+            txs.push_back(std::move(tx));
+        }
+        catch (std::exception& e)
+        {
+            SYNCLOG(TRACE) << "[Tx] Drop invalid peer transaction [reason/peer]: " << e.what()
+                           << "/" << _packet.nodeId << endl;
+        }
+    }
+    // an invalid transaction only drops itself, the others of the packet are imported
+    recoverSenders(txs, false);
 
+    for (auto& tx : txs)
+    {
+        try
+        {
+            tx.sender();
+        }
+        catch (std::exception const&)
+        {
+            SYNCLOG(TRACE) << "[Tx] Drop peer transaction of invalid signature [txHash/peer]: "
+                           << tx.sha3() << "/" << _packet.nodeId << endl;
+            continue;
+        }
         auto importResult = m_txPool->import(tx);
         if (ImportResult::Success == importResult)
             successCnt++;
@@ -389,6 +389,23 @@ Transactions TxPool::pendingList() const
     return ret;
 }
 
+/// get the pending transactions of the given hashes under one lock
+std::vector<size_t> TxPool::pendingTransactions(h256s const& _hashes, Transactions& o_txs)
+{
+    std::vector<size_t> missing;
+    o_txs.resize(_hashes.size());
+    ReadGuard l(m_lock);
+    for (size_t i = 0; i < _hashes.size(); ++i)
+    {
+        auto it = m_txsHash.find(_hashes[i]);
+        if (it == m_txsHash.end())
+            missing.push_back(i);
+        else
+            o_txs[i] = *(it->second);
+    }
+    return missing;
+}
+
 /// get current transaction num
 size_t TxPool::pendingSize()
 {
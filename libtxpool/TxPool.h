@@ -118,6 +118,7 @@ public:
     Transactions pendingList() const override;
     /// get current transaction num
     size_t pendingSize() override;
+    std::vector<size_t> pendingTransactions(h256s const& _hashes, Transactions& o_txs) override;
 
     /// @returns the status of the transaction queue.
     TxPoolStatus status() const override;
@@ -65,6 +65,22 @@ public:
     virtual dev::eth::Transactions pendingList() const = 0;
     /// get current transaction num
     virtual size_t pendingSize() = 0;
+    /**
+     * @brief get the pending transactions of the given hashes, e.g. to rebuild the block of a
+     * compact prepare request
+     * @param _hashes : the transaction hashes
+     * @param o_txs : resized to the hashes, filled with the transactions found in the queue
+     * @return the indexes of the hashes whose transactions aren't in the queue
+     */
+    virtual std::vector<size_t> pendingTransactions(
+        h256s const& _hashes, dev::eth::Transactions& o_txs)
+    {
+        o_txs.resize(_hashes.size());
+        std::vector<size_t> missing(_hashes.size());
+        for (size_t i = 0; i < missing.size(); ++i)
+            missing[i] = i;
+        return missing;
+    }
 
     /**
      * @brief submit a transaction through RPC
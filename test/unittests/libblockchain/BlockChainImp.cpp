@@ -277,6 +277,23 @@ BOOST_AUTO_TEST_CASE(getLocalisedTxReceiptByHash)
     BOOST_CHECK_EQUAL(localisedTxReceipt.hash(), h256(c_commonHashPrefix));
 }
 
+BOOST_AUTO_TEST_CASE(headHeader)
+{
+    auto header = m_blockChainImp->headHeader();
+    BOOST_CHECK(header != nullptr);
+    BOOST_CHECK_EQUAL(header->hash(), m_fakeBlock->getBlock().blockHeader().hash());
+
+    auto fakeBlock2 = std::make_shared<FakeBlock>(10);
+    fakeBlock2->getBlock().header().setNumber(m_blockChainImp->number() + 1);
+    fakeBlock2->getBlock().header().setParentHash(
+        m_blockChainImp->numberHash(m_blockChainImp->number()));
+    auto commitResult = m_blockChainImp->commitBlock(fakeBlock2->getBlock(), m_executiveContext);
+    BOOST_CHECK(commitResult == CommitResult::OK);
+    header = m_blockChainImp->headHeader();
+    BOOST_CHECK_EQUAL(header->number(), 1);
+    BOOST_CHECK_EQUAL(header->hash(), fakeBlock2->getBlock().blockHeader().hash());
+}
+
 BOOST_AUTO_TEST_CASE(commitBlock)
 {
     auto fakeBlock2 = std::make_shared<FakeBlock>(10);
@@ -293,6 +310,8 @@ BOOST_AUTO_TEST_CASE(commitBlock)
     commitResult = m_blockChainImp->commitBlock(fakeBlock2->getBlock(), m_executiveContext);
     BOOST_CHECK(commitResult == CommitResult::OK);
     BOOST_CHECK_EQUAL(m_blockChainImp->number(), 1);
+    BOOST_CHECK_EQUAL(
+        m_blockChainImp->numberHash(1), fakeBlock2->getBlock().blockHeader().hash());
     BOOST_CHECK_EQUAL(m_blockChainImp->totalTransactionCount().first, 15);
     BOOST_CHECK_EQUAL(m_blockChainImp->totalTransactionCount().second, 1);
 
@@ -0,0 +1,76 @@
+/**
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ *
+ * @brief
+ *
+ * @file BlockHashRingTest.cpp
+ */
+#include <libblockchain/BlockHashRing.h>
+#include <test/tools/libutils/TestOutputHelper.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace dev;
+using namespace dev::blockchain;
+
+namespace dev
+{
+namespace test
+{
+BOOST_FIXTURE_TEST_SUITE(BlockHashRingTest, TestOutputHelperFixture)
+
+BOOST_AUTO_TEST_CASE(lastBlocks)
+{
+    BlockHashRing ring(4);
+    h256 hash;
+    BOOST_CHECK(!ring.get(0, hash));
+    for (int64_t i = 0; i < 6; ++i)
+        ring.insert(i, h256(i + 1));
+
+    // the blocks 0 and 1 are dropped by the blocks 4 and 5
+    BOOST_CHECK(!ring.get(0, hash));
+    BOOST_CHECK(!ring.get(1, hash));
+    BOOST_CHECK(!ring.get(6, hash));
+    BOOST_CHECK(!ring.get(-1, hash));
+    for (int64_t i = 2; i < 6; ++i)
+    {
+        BOOST_CHECK(ring.get(i, hash));
+        BOOST_CHECK_EQUAL(hash, h256(i + 1));
+    }
+
+    // a block older than the ring doesn't drop a newer one
+    ring.insert(1, h256(2));
+    BOOST_CHECK(!ring.get(1, hash));
+    BOOST_CHECK(ring.get(5, hash));
+}
+
+BOOST_AUTO_TEST_CASE(sparseBlocks)
+{
+    BlockHashRing ring(4);
+    h256 hash;
+    ring.insert(1, h256(1));
+    ring.insert(100, h256(100));
+    BOOST_CHECK(ring.get(100, hash));
+    // a block read within the ring below the latest one is kept
+    ring.insert(98, h256(98));
+    BOOST_CHECK(ring.get(98, hash));
+    BOOST_CHECK_EQUAL(hash, h256(98));
+    BOOST_CHECK(!ring.get(102, hash));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace test
+}  // namespace dev
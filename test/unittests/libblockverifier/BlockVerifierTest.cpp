@@ -20,12 +20,15 @@
  * @author:
  * @date 2018-09-21
  */
+#include "../libstorage/MemoryStorage.h"
 #include <leveldb/db.h>
 #include <libblockchain/BlockChainImp.h>
 #include <libblockverifier/BlockVerifier.h>
+#include <libethcore/ABI.h>
 #include <libethcore/PrecompiledContract.h>
 #include <libmptstate/MPTStateFactory.h>
 #include <libstorage/LevelDBStorage.h>
+#include <libstoragestate/StorageStateFactory.h>
 #include <test/tools/libutils/TestOutputHelper.h>
 #include <test/unittests/libethcore/FakeBlock.h>
 #include <boost/test/unit_test.hpp>
@@ -108,6 +111,48 @@ struct BlockVerifierFixture
     std::unordered_map<Address, dev::eth::PrecompiledContract> m_precompiledContract;
 };
 
+/// a block verifier on the empty storage state of a chain of _chainVersion
+std::shared_ptr<BlockVerifier> createStorageStateVerifier(unsigned _chainVersion)
+{
+    auto executiveContextFactory = std::make_shared<ExecutiveContextFactory>();
+    executiveContextFactory->setStateStorage(std::make_shared<MemoryStorage>());
+    executiveContextFactory->setStateFactory(
+        std::make_shared<dev::storagestate::StorageStateFactory>(u256(0), _chainVersion));
+    executiveContextFactory->setChainVersion(_chainVersion);
+    auto blockVerifier = std::make_shared<BlockVerifier>();
+    blockVerifier->setExecutiveContextFactory(executiveContextFactory);
+    blockVerifier->setNumberHash([](int64_t) { return h256(); });
+    return blockVerifier;
+}
+
+/// a block opening a table twice through the table factory precompiled without a value
+Block createOpenTableBlock()
+{
+    KeyPair keyPair = KeyPair::create();
+    ContractABI abi;
+    Block block;
+    block.header().setNumber(1);
+    block.header().setGasLimit(u256(3000000000));
+    for (size_t i = 0; i < 2; ++i)
+    {
+        Transaction tx(u256(0), u256(0), u256(30000000), Address(0x1001),
+            abi.abiIn("openTable(string)", std::string("_sys_miners_")), u256(i));
+        tx.setBlockLimit(u256(100));
+        SignatureStruct sig = dev::sign(keyPair.secret(), tx.sha3(WithoutSignature));
+        tx.updateSignature(sig);
+        block.appendTransaction(tx);
+    }
+    return block;
+}
+
+Address openedTable(TransactionReceipt const& _receipt)
+{
+    ContractABI abi;
+    Address address;
+    abi.abiOut(bytesConstRef(&_receipt.outputBytes()), address);
+    return address;
+}
+
 BOOST_FIXTURE_TEST_SUITE(BlockVerifierTest, BlockVerifierFixture);
 
 
@@ -145,6 +190,33 @@ BOOST_AUTO_TEST_CASE(executeBlock)
      }*/
 }
 
+BOOST_AUTO_TEST_CASE(replayLegacyBlock)
+{
+    // the chains created without a version keep executing blocks as they were first executed
+    BlockInfo parentBlockInfo{h256(), 0, h256()};
+    Block block = createOpenTableBlock();
+    auto context = createStorageStateVerifier(0)->executeBlock(block, parentBlockInfo);
+    BOOST_TEST(block.transactionReceipts().size() == 2u);
+    // the registered addresses are numbered through the block and the called precompiled
+    // account is created by the zero value transfer
+    BOOST_TEST(openedTable(block.transactionReceipts()[0]) == Address(0x10001));
+    BOOST_TEST(openedTable(block.transactionReceipts()[1]) == Address(0x10002));
+    BOOST_TEST(context->getState()->addressInUse(Address(0x1001)));
+
+    // replaying the block on its pre-state verifies its state and receipt roots
+    Block replayed = block;
+    BOOST_CHECK_NO_THROW(createStorageStateVerifier(0)->executeBlock(replayed, parentBlockInfo));
+    BOOST_TEST(replayed.header().stateRoot() == block.header().stateRoot());
+    BOOST_TEST(replayed.header().receiptsRoot() == block.header().receiptsRoot());
+
+    // the chains of version 1 restart the registered addresses for every transaction and don't
+    // touch the precompiled account, which changes both roots
+    Block versioned = createOpenTableBlock();
+    context = createStorageStateVerifier(1)->executeBlock(versioned, parentBlockInfo);
+    BOOST_TEST(openedTable(versioned.transactionReceipts()[1]) == Address(0x10001));
+    BOOST_TEST(!context->getState()->addressInUse(Address(0x1001)));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }  // namespace test
@@ -0,0 +1,102 @@
+/**
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ *
+ * @brief
+ *
+ * @file CallCacheTest.cpp
+ */
+#include <libblockverifier/CallCache.h>
+#include <test/tools/libutils/TestOutputHelper.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace dev;
+using namespace dev::eth;
+using namespace dev::blockverifier;
+
+namespace dev
+{
+namespace test
+{
+namespace
+{
+Transaction callTransaction(Address const& _to, bytes const& _data)
+{
+    Transaction tx(u256(0), u256(0), u256(300000000), _to, _data, u256(0));
+    tx.forceSender(Address(0x1234));
+    return tx;
+}
+
+CallCache::Result callResult(size_t _outputSize)
+{
+    CallCache::Result result;
+    result.first.output = bytes(_outputSize, 0x01);
+    return result;
+}
+}  // namespace
+
+BOOST_FIXTURE_TEST_SUITE(CallCacheTest, TestOutputHelperFixture)
+
+BOOST_AUTO_TEST_CASE(getAndStore)
+{
+    CallCache cache(1024 * 1024);
+    auto tx = callTransaction(Address(0x1001), bytes{0x01, 0x02});
+    CallCache::Result result;
+    BOOST_CHECK(!cache.get(h256(0x01), tx, result));
+    cache.store(h256(0x01), tx, callResult(32));
+    BOOST_CHECK(cache.get(h256(0x01), tx, result));
+    BOOST_CHECK_EQUAL(result.first.output.size(), 32);
+
+    // another block, receiver, data or sender is another call
+    BOOST_CHECK(!cache.get(h256(0x02), tx, result));
+    BOOST_CHECK(!cache.get(h256(0x01), callTransaction(Address(0x1002), tx.data()), result));
+    BOOST_CHECK(!cache.get(h256(0x01), callTransaction(Address(0x1001), bytes{0x01}), result));
+    auto other = tx;
+    other.forceSender(Address(0x5678));
+    BOOST_CHECK(!cache.get(h256(0x01), other, result));
+    BOOST_CHECK_EQUAL(cache.hits(), 1);
+    BOOST_CHECK_EQUAL(cache.misses(), 5);
+
+    cache.clear();
+    BOOST_CHECK(!cache.get(h256(0x01), tx, result));
+    BOOST_CHECK_EQUAL(cache.bytes(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(evict)
+{
+    CallCache cache(8192);
+    auto tx1 = callTransaction(Address(0x1001), bytes{0x01});
+    auto tx2 = callTransaction(Address(0x1001), bytes{0x02});
+    auto tx3 = callTransaction(Address(0x1001), bytes{0x03});
+    CallCache::Result result;
+    cache.store(h256(0x01), tx1, callResult(2500));
+    cache.store(h256(0x01), tx2, callResult(2500));
+    // tx1 is the most recently used
+    BOOST_CHECK(cache.get(h256(0x01), tx1, result));
+    cache.store(h256(0x01), tx3, callResult(2500));
+    BOOST_CHECK(cache.bytes() <= 8192);
+    BOOST_CHECK(cache.get(h256(0x01), tx1, result));
+    BOOST_CHECK(!cache.get(h256(0x01), tx2, result));
+    BOOST_CHECK(cache.get(h256(0x01), tx3, result));
+
+    // a result larger than the cache isn't cached
+    cache.store(h256(0x02), tx1, callResult(16384));
+    BOOST_CHECK(!cache.get(h256(0x02), tx1, result));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace test
+}  // namespace dev
@@ -0,0 +1,99 @@
+/**
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ *
+ * @brief
+ *
+ * @file ExecutionProfilerTest.cpp
+ */
+#include <libblockverifier/ExecutionProfiler.h>
+#include <test/tools/libutils/TestOutputHelper.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace dev;
+using namespace dev::blockverifier;
+
+namespace dev
+{
+namespace test
+{
+namespace
+{
+TransactionProfile transactionProfile(Address const& _contract, uint64_t _timeUs)
+{
+    TransactionProfile profile;
+    profile.contract = _contract;
+    profile.timeUs = _timeUs;
+    profile.gasUsed = 100;
+    profile.selects = 2;
+    profile.loads = 1;
+    profile.writes = 3;
+    profile.opcodes[0x01] = 5;
+    return profile;
+}
+}  // namespace
+
+BOOST_FIXTURE_TEST_SUITE(ExecutionProfilerTest, TestOutputHelperFixture)
+
+BOOST_AUTO_TEST_CASE(aggregate)
+{
+    ExecutionProfiler profiler(16, 0);
+    profiler.addTransaction(1, transactionProfile(Address(0x1001), 10));
+    profiler.addTransaction(1, transactionProfile(Address(0x1002), 20));
+    profiler.addTransaction(1, transactionProfile(Address(0x1001), 30));
+    profiler.finishBlock(1, 2, 100, 40);
+
+    auto blocks = profiler.blockProfiles();
+    BOOST_CHECK_EQUAL(blocks.size(), 1);
+    auto block = blocks[0];
+    BOOST_CHECK_EQUAL(block->number, 1);
+    BOOST_CHECK_EQUAL(block->timeUs, 100);
+    BOOST_CHECK_EQUAL(block->hashUs, 40);
+    BOOST_CHECK_EQUAL(block->transactions, 2);
+    BOOST_CHECK_EQUAL(block->executions.size(), 3);
+    BOOST_CHECK_EQUAL(block->total.timeUs, 60);
+    BOOST_CHECK(block->total.gasUsed == u256(300));
+    BOOST_CHECK_EQUAL(block->total.selects, 6);
+    BOOST_CHECK_EQUAL(block->total.loads, 3);
+    BOOST_CHECK_EQUAL(block->total.writes, 9);
+    BOOST_CHECK_EQUAL(block->total.opcodes[0x01], 15);
+    BOOST_CHECK_EQUAL(block->contracts.size(), 2);
+    BOOST_CHECK_EQUAL(block->contracts.at(Address(0x1001)).timeUs, 40);
+    BOOST_CHECK_EQUAL(block->contracts.at(Address(0x1002)).timeUs, 20);
+}
+
+BOOST_AUTO_TEST_CASE(lastBlocks)
+{
+    ExecutionProfiler profiler(2, 1);
+    // the block failed to execute is dropped with the later block
+    profiler.addTransaction(1, transactionProfile(Address(0x1001), 10));
+    profiler.addTransaction(2, transactionProfile(Address(0x1001), 10));
+    profiler.finishBlock(2, 1, 10);
+    profiler.finishBlock(1, 1, 10);
+    BOOST_CHECK(profiler.blockProfiles()[1]->executions.empty());
+
+    profiler.addTransaction(3, transactionProfile(Address(0x1001), 10));
+    profiler.finishBlock(3, 1, 10);
+    auto blocks = profiler.blockProfiles();
+    BOOST_CHECK_EQUAL(blocks.size(), 2);
+    BOOST_CHECK_EQUAL(blocks[0]->number, 1);
+    BOOST_CHECK_EQUAL(blocks[1]->number, 3);
+    BOOST_CHECK_EQUAL(blocks[1]->executions.size(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace test
+}  // namespace dev
@@ -0,0 +1,130 @@
+/**
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ *
+ * @brief
+ *
+ * @file ExecutiveContextFactoryTest.cpp
+ */
+#include "../libstorage/MemoryStorage.h"
+#include <libblockverifier/ExecutiveContextFactory.h>
+#include <libstorage/CRUDPrecompiled.h>
+#include <libstoragestate/StorageStateFactory.h>
+#include <test/tools/libutils/TestOutputHelper.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace dev;
+using namespace dev::blockverifier;
+
+namespace dev
+{
+namespace test
+{
+struct ExecutiveContextFactoryFixture : public TestOutputHelperFixture
+{
+    ExecutiveContextFactoryFixture()
+    {
+        factory = std::make_shared<ExecutiveContextFactory>();
+        factory->setStateStorage(std::make_shared<dev::storage::MemoryStorage>());
+        factory->setStateFactory(std::make_shared<dev::storagestate::StorageStateFactory>(0));
+        blockInfo = BlockInfo{h256(0x01), 1, h256(0)};
+    }
+
+    ExecutiveContextFactory::Ptr factory;
+    BlockInfo blockInfo;
+};
+
+BOOST_FIXTURE_TEST_SUITE(ExecutiveContextFactoryTest, ExecutiveContextFactoryFixture)
+
+BOOST_AUTO_TEST_CASE(reuseContext)
+{
+    auto context = factory->createExecutiveContext(blockInfo, h256(0));
+    auto memoryTableFactory = context->getMemoryTableFactory();
+    BOOST_TEST(context->isPrecompiled(Address(0x1001)));
+    BOOST_TEST(context->isOrginPrecompiled(Address(1)));
+    BOOST_TEST(context->blockInfo().number == 1);
+    BOOST_TEST(memoryTableFactory->createTable("t_test", "id", "name") != nullptr);
+    Address address = context->registerPrecompiled(std::make_shared<CRUDPrecompiled>());
+    BOOST_TEST(context->isPrecompiled(address));
+    ExecutiveContext* released = context.get();
+    memoryTableFactory.reset();
+    context.reset();
+    BOOST_TEST(factory->pooledContexts() == 1u);
+
+    // the context and its table factory are reset and reused
+    blockInfo.number = 2;
+    context = factory->createExecutiveContext(blockInfo, h256(0));
+    BOOST_TEST(factory->pooledContexts() == 0u);
+    BOOST_TEST(context.get() == released);
+    BOOST_TEST(context->blockInfo().number == 2);
+    BOOST_TEST(context->isPrecompiled(Address(0x1001)));
+    BOOST_TEST(!context->isPrecompiled(address));
+    BOOST_TEST(context->getMemoryTableFactory()->openTable("t_test") == nullptr);
+    BOOST_TEST(context->registerPrecompiled(std::make_shared<CRUDPrecompiled>()) == address);
+}
+
+BOOST_AUTO_TEST_CASE(keptTableFactory)
+{
+    auto context = factory->createExecutiveContext(blockInfo, h256(0));
+    auto memoryTableFactory = context->getMemoryTableFactory();
+    memoryTableFactory->createTable("t_test", "id", "name");
+    context.reset();
+
+    // the table factory still referred isn't reset or reused
+    context = factory->createExecutiveContext(blockInfo, h256(0));
+    BOOST_TEST(context->getMemoryTableFactory() != memoryTableFactory);
+    BOOST_TEST(memoryTableFactory->openTable("t_test") != nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(registeredPrecompiled)
+{
+    auto context = factory->createExecutiveContext(blockInfo, h256(0));
+    auto first = std::make_shared<CRUDPrecompiled>();
+    auto second = std::make_shared<CRUDPrecompiled>();
+    Address firstAddress = context->registerPrecompiled(first);
+    Address secondAddress = context->registerPrecompiled(second);
+    BOOST_TEST(firstAddress == Address(0x10001));
+    BOOST_TEST(secondAddress == Address(0x10002));
+    BOOST_TEST(context->getPrecompiled(firstAddress) == first);
+    BOOST_TEST(context->getPrecompiled(secondAddress) == second);
+    BOOST_TEST(!context->isPrecompiled(Address(0x10000)));
+    BOOST_TEST(!context->isPrecompiled(Address(0x10003)));
+    BOOST_TEST(!context->isPrecompiled(Address(u160(1) << 32 | 0x10001)));
+
+    // the next transaction gets the same addresses
+    context->clearRegisteredPrecompiled();
+    BOOST_TEST(!context->isPrecompiled(firstAddress));
+    BOOST_TEST(context->isPrecompiled(Address(0x1001)));
+    BOOST_TEST(context->registerPrecompiled(second) == firstAddress);
+    BOOST_TEST(context->getPrecompiled(firstAddress) == second);
+}
+
+BOOST_AUTO_TEST_CASE(sharedPrecompiled)
+{
+    auto context = factory->createExecutiveContext(blockInfo, h256(0));
+    auto other = factory->createExecutiveContext(blockInfo, h256(0));
+    BOOST_TEST(context.get() != other.get());
+    BOOST_TEST(context->getPrecompiled(Address(0x1002)) == other->getPrecompiled(Address(0x1002)));
+    BOOST_TEST(context->getMemoryTableFactory() != other->getMemoryTableFactory());
+    // contexts released after the factory are freed
+    factory.reset();
+    context.reset();
+    other.reset();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace test
+}  // namespace dev
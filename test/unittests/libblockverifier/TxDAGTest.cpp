@@ -0,0 +1,74 @@
+/**
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ *
+ * @brief
+ *
+ * @file TxDAGTest.cpp
+ */
+#include <libblockverifier/TxDAG.h>
+#include <test/tools/libutils/TestOutputHelper.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace dev;
+using namespace dev::blockverifier;
+
+namespace dev
+{
+namespace test
+{
+BOOST_FIXTURE_TEST_SUITE(TxDAGTest, TestOutputHelperFixture)
+
+BOOST_AUTO_TEST_CASE(schedule)
+{
+    std::vector<ConflictKeys> conflictKeys{
+        {{"t", "a"}},  // 0
+        {{"t", "b"}},  // 1
+        {{"t", "a"}},  // 2 depends on 0
+        {},            // 3 depends on all preceding transactions
+        {{"u", ""}},   // 4 depends on 3
+        {{"u", "x"}},  // 5 depends on 4
+    };
+    TxDAG dag(conflictKeys);
+    BOOST_CHECK_EQUAL(dag.waitReady(), 0);
+    dag.done(0);
+    BOOST_CHECK_EQUAL(dag.waitReady(), 1);
+    BOOST_CHECK_EQUAL(dag.waitReady(), 2);
+    dag.done(2);
+    dag.done(1);
+    BOOST_CHECK_EQUAL(dag.waitReady(), 3);
+    dag.done(3);
+    BOOST_CHECK_EQUAL(dag.waitReady(), 4);
+    dag.done(4);
+    BOOST_CHECK_EQUAL(dag.waitReady(), 5);
+    dag.done(5);
+    BOOST_CHECK_EQUAL(dag.waitReady(), -1);
+    BOOST_CHECK(!dag.stopped());
+}
+
+BOOST_AUTO_TEST_CASE(stop)
+{
+    std::vector<ConflictKeys> conflictKeys{{{"t", "a"}}, {{"t", "a"}}};
+    TxDAG dag(conflictKeys);
+    BOOST_CHECK_EQUAL(dag.waitReady(), 0);
+    dag.stop();
+    BOOST_CHECK_EQUAL(dag.waitReady(), -1);
+    BOOST_CHECK(dag.stopped());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace test
+}  // namespace dev
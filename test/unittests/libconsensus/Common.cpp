@@ -141,6 +141,70 @@ BOOST_AUTO_TEST_CASE(testPrepareReq)
     BOOST_CHECK(new_req.block == encodedData);
 }
 
+/// test CompactBlock
+BOOST_AUTO_TEST_CASE(testCompactBlock)
+{
+    FakeBlock fake_block(5);
+    CompactBlock compact_block(fake_block.m_block);
+    BOOST_CHECK(compact_block.header.hash() == fake_block.m_block.header().hash());
+    BOOST_CHECK(compact_block.transactionHashes.size() == 5);
+    BOOST_CHECK(compact_block.transactionHashes[3] == fake_block.m_block.transaction(3).sha3());
+    bytes compact_data;
+    BOOST_REQUIRE_NO_THROW(compact_block.encode(compact_data));
+    BOOST_CHECK(compact_data.size() < fake_block.m_blockData.size());
+    CompactBlock decoded_block;
+    BOOST_REQUIRE_NO_THROW(decoded_block.decode(ref(compact_data)));
+    BOOST_CHECK(decoded_block.header.hash() == fake_block.m_block.header().hash());
+    BOOST_CHECK(decoded_block.transactionHashes == compact_block.transactionHashes);
+
+    /// rebuild the block from the transactions
+    Block rebuilt_block;
+    rebuilt_block.setBlockHeader(decoded_block.header);
+    rebuilt_block.setTransactions(fake_block.m_block.transactions());
+    bytes rebuilt_data;
+    rebuilt_block.encode(rebuilt_data);
+    Block tmp_block;
+    BOOST_REQUIRE_NO_THROW(tmp_block.decode(ref(rebuilt_data)));
+    BOOST_CHECK(tmp_block.header().hash() == fake_block.m_block.header().hash());
+    BOOST_CHECK(tmp_block.transactions() == fake_block.m_block.transactions());
+    /// test decode exception
+    compact_data[0] += 1;
+    BOOST_CHECK_THROW(decoded_block.decode(ref(compact_data)), std::exception);
+}
+
+/// test TransactionsReq
+BOOST_AUTO_TEST_CASE(testTransactionsReq)
+{
+    FakeBlock fake_block(5);
+    TransactionsReq req;
+    req.block_hash = fake_block.m_block.header().hash();
+    req.indexes = {1, 4};
+    bytes req_data;
+    BOOST_REQUIRE_NO_THROW(req.encode(req_data));
+    TransactionsReq decoded_req;
+    BOOST_REQUIRE_NO_THROW(decoded_req.decode(ref(req_data)));
+    BOOST_CHECK(decoded_req.block_hash == req.block_hash);
+    BOOST_CHECK(decoded_req.indexes == req.indexes);
+    BOOST_CHECK(decoded_req.transactions.empty());
+
+    /// the response carries the encoded transactions
+    for (auto index : req.indexes)
+    {
+        bytes tx_data;
+        fake_block.m_block.transaction(index).encode(tx_data);
+        req.transactions.push_back(tx_data);
+    }
+    BOOST_REQUIRE_NO_THROW(req.encode(req_data));
+    BOOST_REQUIRE_NO_THROW(decoded_req.decode(ref(req_data)));
+    BOOST_CHECK(decoded_req.transactions == req.transactions);
+    Transaction tx;
+    BOOST_REQUIRE_NO_THROW(tx.decode(ref(decoded_req.transactions[1])));
+    BOOST_CHECK(tx.sha3() == fake_block.m_block.transaction(4).sha3());
+    /// test decode exception
+    req_data[0] += 1;
+    BOOST_CHECK_THROW(decoded_req.decode(ref(req_data)), std::exception);
+}
+
 /// test SignReq and CommitReq
 BOOST_AUTO_TEST_CASE(testSignReqAndCommitReq)
 {
@@ -175,6 +175,22 @@ public:
     void setNodeIdx(IDXTYPE const& _idx) { m_idx = _idx; }
     void collectGarbage() { return PBFTEngine::collectGarbage(); }
     void handleFutureBlock() { return PBFTEngine::handleFutureBlock(); }
+    void setPendingPrepare(
+        PrepareReq const& req, std::vector<unsigned> const& missing, h512s const& sources)
+    {
+        m_pendingPrepare = req;
+        m_missingTransactions = missing;
+        m_pendingSources = sources;
+        m_pendingRequests = 0;
+        m_pendingRequestTime = 0;
+    }
+    void expirePendingRequest() { m_pendingRequestTime = 0; }
+    bool hasPendingPrepare() const { return !m_missingTransactions.empty(); }
+    void checkPendingPrepare() { return PBFTEngine::checkPendingPrepare(); }
+    void handleTransactionsReqMsg(PBFTMsgPacket const& pbftMsg)
+    {
+        return PBFTEngine::handleTransactionsReqMsg(pbftMsg);
+    }
 };
 
 template <typename T>
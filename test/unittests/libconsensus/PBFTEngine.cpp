@@ -647,6 +647,84 @@ BOOST_AUTO_TEST_CASE(testHandleFutureBlock)
     BOOST_CHECK(fake_pbft.consensus()->reqCache()->futurePrepareCache().block_hash == h256());
 }
 
+/// test the retries of the missing transactions of a compact prepare
+BOOST_AUTO_TEST_CASE(testRetryMissingTransactions)
+{
+    FakeConsensus<FakePBFTEngine> fake_pbft(1, ProtocolID::PBFT);
+    PrepareReq prepareReq;
+    prepareReq.height = fake_pbft.consensus()->mutableConsensusNumber();
+    prepareReq.view = fake_pbft.consensus()->view();
+    prepareReq.block_hash = sha3("compact prepare");
+    KeyPair leader = KeyPair::create();
+    KeyPair forwarder = KeyPair::create();
+    fake_pbft.consensus()->setPendingPrepare(
+        prepareReq, std::vector<unsigned>{0, 2}, h512s{leader.pub(), forwarder.pub()});
+
+    /// no retry before the interval
+    fake_pbft.consensus()->checkPendingPrepare();
+    fake_pbft.consensus()->checkPendingPrepare();
+    compareAsyncSendTime(fake_pbft, leader.pub(), 1);
+    compareAsyncSendTime(fake_pbft, forwarder.pub(), 0);
+
+    /// the leader and the forwarder are asked in turn, then the prepare is given up
+    for (size_t i = 1; i < 6; ++i)
+    {
+        fake_pbft.consensus()->expirePendingRequest();
+        fake_pbft.consensus()->checkPendingPrepare();
+    }
+    compareAsyncSendTime(fake_pbft, leader.pub(), 3);
+    compareAsyncSendTime(fake_pbft, forwarder.pub(), 2);
+    BOOST_CHECK(fake_pbft.consensus()->hasPendingPrepare() == false);
+}
+
+/// test handleTransactionsReqMsg
+BOOST_AUTO_TEST_CASE(testHandleTransactionsReqMsg)
+{
+    FakeConsensus<FakePBFTEngine> fake_pbft(1, ProtocolID::PBFT);
+    FakeService* service =
+        dynamic_cast<FakeService*>(fake_pbft.consensus()->mutableService().get());
+    PrepareReq prepareReq;
+    prepareReq.block_hash = sha3("raw prepare");
+    RLPStream block(2);
+    block << bytes();
+    block.appendList(3);
+    for (unsigned i = 0; i < 3; ++i)
+        block.appendRaw(rlpList(i));
+    block.swapOut(prepareReq.block);
+    fake_pbft.consensus()->reqCache()->addRawPrepare(prepareReq);
+
+    TransactionsReq req;
+    req.block_hash = prepareReq.block_hash;
+    req.indexes = std::vector<unsigned>{2, 0, 2, 2};
+    PBFTMsgPacket pbftMsg;
+    KeyPair peer_keyPair = KeyPair::create();
+    pbftMsg.node_id = peer_keyPair.pub();
+    req.encode(pbftMsg.data);
+    /// the request of a non-sealer isn't served
+    fake_pbft.consensus()->handleTransactionsReqMsg(pbftMsg);
+    compareAsyncSendTime(fake_pbft, peer_keyPair.pub(), 0);
+
+    /// the duplicate indexes are served once
+    FakePBFTMinerByKeyPair(fake_pbft, peer_keyPair);
+    fake_pbft.consensus()->handleTransactionsReqMsg(pbftMsg);
+    compareAsyncSendTime(fake_pbft, peer_keyPair.pub(), 1);
+    PBFTMsgPacket packet;
+    packet.decode(ref(*service->getAsyncSendMessageByNodeID(peer_keyPair.pub())->buffer()));
+    BOOST_CHECK(packet.packet_id == dev::consensus::TransactionsPacket);
+    TransactionsReq resp;
+    resp.decode(ref(packet.data));
+    BOOST_CHECK(resp.indexes == std::vector<unsigned>({0, 2}));
+    BOOST_CHECK(resp.transactions.size() == 2);
+    BOOST_CHECK(resp.transactions[0] == rlpList(0));
+    BOOST_CHECK(resp.transactions[1] == rlpList(2));
+
+    /// the indexes out of the block aren't served
+    req.indexes = std::vector<unsigned>{0, 3};
+    req.encode(pbftMsg.data);
+    fake_pbft.consensus()->handleTransactionsReqMsg(pbftMsg);
+    compareAsyncSendTime(fake_pbft, peer_keyPair.pub(), 1);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 }  // namespace test
 }  // namespace dev
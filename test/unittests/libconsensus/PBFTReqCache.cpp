@@ -239,6 +239,45 @@ BOOST_AUTO_TEST_CASE(testViewChangeReqRelated)
     req_cache.clearAllExceptCommitCache();
     BOOST_CHECK(req_cache.getViewChangeSize(1) == 0);
 }
+/// test the prepare cache of the next height in pipelined mode
+BOOST_AUTO_TEST_CASE(testNextPrepareCache)
+{
+    PBFTReqCache req_cache(0);
+    KeyPair key_pair;
+    PrepareReq prepare_req = FakePrepareReq(key_pair);
+    req_cache.addRawPrepare(prepare_req);
+    req_cache.addPrepareReq(prepare_req);
+
+    /// add the next prepare and its signReq
+    PrepareReq next_req(prepare_req);
+    next_req.height = prepare_req.height + 1;
+    next_req.block_hash = sha3("next_block");
+    req_cache.addNextPrepareReq(next_req, next_req);
+    BOOST_CHECK(req_cache.isExistNextPrepare(next_req));
+    BOOST_CHECK(!req_cache.isExistPrepare(next_req));
+    SignReq sign_req(next_req, key_pair, next_req.idx);
+    req_cache.addSignReq(sign_req);
+    SignReq current_sign(prepare_req, key_pair, prepare_req.idx);
+    req_cache.addSignReq(current_sign);
+
+    /// the signReqs of the next height are kept after the current block is committed
+    req_cache.clearAllExceptCommitCache();
+    BOOST_CHECK(req_cache.getSigCacheSize(next_req.block_hash) == 1);
+    BOOST_CHECK(req_cache.getSigCacheSize(prepare_req.block_hash) == 0);
+    req_cache.promoteNextPrepare();
+    BOOST_CHECK(req_cache.isExistPrepare(next_req));
+    BOOST_CHECK(req_cache.prepareCache().block_hash == next_req.block_hash);
+    BOOST_CHECK(req_cache.prepareCache().height == next_req.height);
+    BOOST_CHECK(req_cache.getSigCacheSize(next_req.block_hash) == 1);
+    BOOST_CHECK(!req_cache.isExistNextPrepare(next_req));
+    checkPBFTMsg(req_cache.nextPrepareCache());
+
+    /// the next height is dropped with a view change
+    req_cache.addNextPrepareReq(next_req, next_req);
+    req_cache.triggerViewChange(1);
+    BOOST_CHECK(!req_cache.isExistNextPrepare(next_req));
+    checkPBFTMsg(req_cache.nextRawPrepareCache());
+}
 BOOST_AUTO_TEST_SUITE_END()
 }  // namespace test
 }  // namespace dev
@@ -0,0 +1,156 @@
+/**
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ *
+ * @brief
+ *
+ * @file ABICodec.cpp
+ */
+
+#include <libdevcore/Address.h>
+#include <libethcore/ABI.h>
+#include <libethcore/ABICodec.h>
+#include <test/tools/libutils/TestOutputHelper.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+
+namespace dev
+{
+namespace test
+{
+BOOST_FIXTURE_TEST_SUITE(ABICodecTest, TestOutputHelperFixture)
+
+BOOST_AUTO_TEST_CASE(sameAsContractABI)
+{
+    u256 x = 12345;
+    Address address("0x1234567890123456789012345678901234567890");
+    string xs("xxxsxxxsxxs");
+    string ys(40, 'y');
+    string32 str32 = toString32("string32");
+    byte b = 'a';
+
+    ContractABI abi;
+    bytes expected = abi.abiIn("", b, xs, x, str32, address, ys, string());
+    bytes out;
+    ABICodec::encode(out, b, xs, x, str32, address, stringConstRef(&ys), string());
+    BOOST_CHECK(out == expected);
+    BOOST_CHECK_EQUAL(ABICodec::encodedSize(b, xs, x, str32, address, ys, string()), out.size());
+
+    // the strings are slices of the encoded parameters
+    byte decodedB;
+    stringConstRef decodedXs;
+    u256 decodedX;
+    string32 decodedStr32;
+    Address decodedAddress;
+    stringConstRef decodedYs;
+    stringConstRef empty;
+    ABICodec::decode(bytesConstRef(&out), decodedB, decodedXs, decodedX, decodedStr32,
+        decodedAddress, decodedYs, empty);
+    BOOST_CHECK_EQUAL(decodedB, b);
+    BOOST_CHECK_EQUAL(decodedXs.toString(), xs);
+    BOOST_CHECK((byte const*)decodedXs.data() > out.data());
+    BOOST_CHECK((byte const*)decodedXs.data() < out.data() + out.size());
+    BOOST_CHECK_EQUAL(decodedX, x);
+    BOOST_CHECK(decodedStr32 == str32);
+    BOOST_CHECK_EQUAL(decodedAddress, address);
+    BOOST_CHECK_EQUAL(decodedYs.toString(), ys);
+    BOOST_CHECK(empty.empty());
+
+    // the output buffer is overwritten
+    ABICodec::encode(out, u256(7));
+    BOOST_CHECK(out == abi.abiIn("", u256(7)));
+}
+
+BOOST_AUTO_TEST_CASE(arrays)
+{
+    // the string[] of the examples of the ABI specification
+    vector<string> strings{"one", "two", "three"};
+    bytes out;
+    ABICodec::encode(out, strings);
+    bytes expected = fromHex(
+        "0000000000000000000000000000000000000000000000000000000000000020"
+        "0000000000000000000000000000000000000000000000000000000000000003"
+        "0000000000000000000000000000000000000000000000000000000000000060"
+        "00000000000000000000000000000000000000000000000000000000000000a0"
+        "00000000000000000000000000000000000000000000000000000000000000e0"
+        "0000000000000000000000000000000000000000000000000000000000000003"
+        "6f6e650000000000000000000000000000000000000000000000000000000000"
+        "0000000000000000000000000000000000000000000000000000000000000003"
+        "74776f0000000000000000000000000000000000000000000000000000000000"
+        "0000000000000000000000000000000000000000000000000000000000000005"
+        "7468726565000000000000000000000000000000000000000000000000000000");
+    BOOST_CHECK(out == expected);
+
+    vector<Address> addresses{Address(1), Address(2)};
+    ABICodec::encode(out, strings, addresses, u256(7));
+    vector<stringConstRef> decodedStrings;
+    vector<Address> decodedAddresses;
+    u256 x;
+    ABICodec::decode(bytesConstRef(&out), decodedStrings, decodedAddresses, x);
+    BOOST_CHECK_EQUAL(decodedStrings.size(), 3);
+    BOOST_CHECK_EQUAL(decodedStrings[2].toString(), "three");
+    BOOST_CHECK(decodedAddresses == addresses);
+    BOOST_CHECK_EQUAL(x, 7);
+
+    // a length beyond the data isn't allocated
+    out[32 * 3 + 31] = 0;
+    out[32 * 3 + 28] = 0xff;
+    ABICodec::decode(bytesConstRef(&out), decodedStrings);
+    BOOST_CHECK(decodedStrings.empty());
+}
+
+BOOST_AUTO_TEST_CASE(boolParameter)
+{
+    bytes out;
+    ABICodec::encode(out, u256(0), true);
+    bool value = false;
+    u256 x;
+    ABICodec::decode(bytesConstRef(&out), x, value);
+    BOOST_CHECK(value);
+    ABICodec::encode(out, u256(1), false);
+    ABICodec::decode(bytesConstRef(&out), x, value);
+    BOOST_CHECK(!value);
+}
+
+BOOST_AUTO_TEST_CASE(outOfRange)
+{
+    // the length of the string is beyond the data
+    bytes data = ContractABI().abiIn("", string("key"), u256(5));
+    data[32 * 2 + 31] = 0xff;
+    stringConstRef key;
+    u256 x;
+    ABICodec::decode(bytesConstRef(&data), key, x);
+    BOOST_CHECK(key.empty());
+    BOOST_CHECK_EQUAL(x, 5);
+
+    // the data of the string and the address are cut
+    Address address;
+    ABICodec::decode(bytesConstRef(&data).cropped(0, 64), key, x, address);
+    BOOST_CHECK(key.empty());
+    BOOST_CHECK_EQUAL(x, 5);
+    BOOST_CHECK(!address);
+
+    ABICodec::decode(bytesConstRef(), key, x);
+    BOOST_CHECK(key.empty());
+    BOOST_CHECK_EQUAL(x, 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace test
+}  // namespace dev
@@ -23,6 +23,7 @@
 #include <libdevcore/Assertions.h>
 #include <libdevcore/CommonJS.h>
 #include <libethcore/CommonJS.h>
+#include <libethcore/SenderCache.h>
 #include <libethcore/Transaction.h>
 #include <test/tools/libutils/TestOutputHelper.h>
 #include <boost/test/unit_test.hpp>
@@ -63,6 +64,37 @@ BOOST_AUTO_TEST_CASE(testCreateTxByRLP)
     /*bytes s;
     BOOST_CHECK_NO_THROW(tx.encode(s, eth::IncludeSignature::WithSignature));*/
 }
+
+BOOST_AUTO_TEST_CASE(testRecoverSenders)
+{
+    SenderCache::instance().clear();
+    Transactions txs;
+    std::vector<Address> senders;
+    for (size_t i = 0; i < 10; ++i)
+    {
+        Transaction tx(u256(i), u256(0), u256(100000000), Address(0x1000 + i), bytes());
+        KeyPair sigKeyPair = KeyPair::create();
+        SignatureStruct sig = dev::sign(sigKeyPair.secret(), tx.sha3(WithoutSignature));
+        tx.updateSignature(sig);
+        bytes encodeBytes;
+        tx.encode(encodeBytes, eth::IncludeSignature::WithSignature);
+        txs.push_back(Transaction(ref(encodeBytes), CheckTransaction::Cheap));
+        senders.push_back(sigKeyPair.address());
+    }
+    recoverSenders(txs);
+    for (size_t i = 0; i < txs.size(); ++i)
+    {
+        BOOST_CHECK(txs[i].sender() == senders[i]);
+        BOOST_CHECK(SenderCache::instance().get(txs[i].sha3()) == senders[i]);
+    }
+    /// the senders of decoded transactions are taken from the cache
+    bytes encodeBytes;
+    txs[0].encode(encodeBytes, eth::IncludeSignature::WithSignature);
+    BOOST_CHECK(Transaction(ref(encodeBytes), CheckTransaction::Everything).sender() == senders[0]);
+
+    txs.push_back(Transaction(u256(0), u256(0), u256(100000000), Address(0x1000), bytes()));
+    BOOST_CHECK_THROW(recoverSenders(txs), TransactionIsUnsigned);
+}
 BOOST_AUTO_TEST_SUITE_END()
 }  // namespace test
 }  // namespace dev
@@ -0,0 +1,89 @@
+/**
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ *
+ * @brief
+ *
+ * @file AnalysisCacheTest.cpp
+ */
+#include <libinterpreter/AnalysisCache.h>
+#include <test/tools/libutils/TestOutputHelper.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace dev;
+using namespace dev::eth;
+
+namespace dev
+{
+namespace test
+{
+namespace
+{
+AnalyzedCode::Ptr analyzedCode(size_t _codeSize)
+{
+    auto analyzed = std::make_shared<AnalyzedCode>();
+    analyzed->code.resize(_codeSize + 33);
+    analyzed->jumpDests.resize(_codeSize);
+    return analyzed;
+}
+}  // namespace
+
+BOOST_FIXTURE_TEST_SUITE(AnalysisCacheTest, TestOutputHelperFixture)
+
+BOOST_AUTO_TEST_CASE(getAndStore)
+{
+    AnalysisCache cache;
+    auto analyzed = analyzedCode(100);
+    BOOST_CHECK(!cache.get(h256(1), 100));
+    cache.store(h256(1), 100, analyzed);
+    // the cached code is shared, not copied
+    BOOST_CHECK(cache.get(h256(1), 100) == analyzed);
+    // a code of another size with the same hash isn't returned
+    BOOST_CHECK(!cache.get(h256(1), 99));
+    BOOST_CHECK_EQUAL(cache.hits(), 1);
+    BOOST_CHECK_EQUAL(cache.misses(), 2);
+    BOOST_CHECK_EQUAL(cache.memory(), analyzed->memorySize());
+
+    cache.store(h256(1), 100, analyzedCode(100));
+    BOOST_CHECK_EQUAL(cache.size(), 1);
+    BOOST_CHECK_EQUAL(cache.memory(), analyzed->memorySize());
+}
+
+BOOST_AUTO_TEST_CASE(leastRecentlyUsed)
+{
+    size_t memory = analyzedCode(1000)->memorySize();
+    AnalysisCache cache(memory * 3);
+    for (unsigned i = 1; i <= 3; ++i)
+        cache.store(h256(i), 1000, analyzedCode(1000));
+    BOOST_CHECK(cache.get(h256(1), 1000));
+
+    // the code 2 is the least recently used one
+    cache.store(h256(4), 1000, analyzedCode(1000));
+    BOOST_CHECK_EQUAL(cache.size(), 3);
+    BOOST_CHECK(!cache.get(h256(2), 1000));
+    BOOST_CHECK(cache.get(h256(1), 1000));
+    BOOST_CHECK(cache.get(h256(3), 1000));
+    BOOST_CHECK(cache.get(h256(4), 1000));
+
+    // a code larger than the cache isn't stored
+    cache.store(h256(5), memory * 3, analyzedCode(memory * 3));
+    BOOST_CHECK(!cache.get(h256(5), memory * 3));
+    BOOST_CHECK_EQUAL(cache.size(), 3);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace test
+}  // namespace dev
@@ -0,0 +1,85 @@
+/**
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ *
+ * @brief
+ *
+ * @file Arith256Test.cpp
+ */
+#include <libinterpreter/Arith256.h>
+#include <test/tools/libutils/TestOutputHelper.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace dev;
+using namespace dev::eth;
+
+namespace dev
+{
+namespace test
+{
+namespace
+{
+std::vector<u256> operands()
+{
+    u256 const max = ~u256(0);
+    return {0, 1, 2, 0xff, u256(1) << 63, (u256(1) << 64) - 1, u256(1) << 64,
+        u256("0x1234567890abcdef1234567890abcdef1234567890abcdef"), u256(1) << 255, max - 1,
+        max};
+}
+}  // namespace
+
+BOOST_FIXTURE_TEST_SUITE(Arith256Test, TestOutputHelperFixture)
+
+BOOST_AUTO_TEST_CASE(mulAndCompare)
+{
+    for (auto const& a : operands())
+    {
+        for (auto const& b : operands())
+        {
+            u256 product;
+            arith256::mul(a, b, product);
+            BOOST_CHECK_EQUAL(product, u256(a * b));
+            BOOST_CHECK_EQUAL(arith256::slt(a, b), u2s(a) < u2s(b));
+        }
+        // the result may be one of the operands
+        u256 square = a;
+        arith256::mul(square, square, square);
+        BOOST_CHECK_EQUAL(square, u256(a * a));
+        BOOST_CHECK_EQUAL(arith256::fitsInWord(a), a <= std::numeric_limits<uint64_t>::max());
+        if (arith256::fitsInWord(a))
+            BOOST_CHECK_EQUAL(u256(arith256::word(a)), a);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(loadBigEndian)
+{
+    bytes data(33, 0);
+    for (size_t i = 0; i < data.size(); ++i)
+        data[i] = byte(0xf0 + i);
+    for (unsigned size = 1; size <= 32; ++size)
+    {
+        u256 expected = 0;
+        for (unsigned i = 0; i < size; ++i)
+            expected = (expected << 8) | data[i];
+        u256 value = 1;
+        arith256::loadBigEndian(data.data(), size, value);
+        BOOST_CHECK_EQUAL(value, expected);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace test
+}  // namespace dev
@@ -135,6 +135,73 @@ BOOST_AUTO_TEST_CASE(addTest)
     BOOST_CHECK(0 == result.status_code);
 }
 
+BOOST_AUTO_TEST_CASE(reusedVMTest)
+{
+    // The VMs are reused by the next calls, which must start with an empty memory
+    // PUSH1 20 PUSH1 00 --> RETURN[size, begin]
+    // MSIZE
+    // PUSH1 00
+    // MSTORE
+    // RETURN
+    dev::eth::EVMSchedule const& schedule = DefaultSchedule;
+    bytes data = fromHex("");
+    Address destination{KeyPair::create().address()};
+    Address caller = destination;
+
+    // leaves 3 in the memory of the VM
+    bytes writeCode = fromHex("602060006001600201600052f3");
+    evmc_result result =
+        evmc.execute(schedule, writeCode, data, destination, caller, 0, 1000000, 0, false, false);
+    BOOST_CHECK(0 == result.status_code);
+
+    bytes readCode = fromHex("6020600059600052f3");
+    for (int i = 0; i < 2; ++i)
+    {
+        result = evmc.execute(
+            schedule, readCode, data, destination, caller, 0, 1000000, 0, false, false);
+        BOOST_CHECK(0 == result.status_code);
+        BOOST_CHECK_EQUAL(result.output_size, 32);
+        u256 r = 0;
+        for (size_t j = 0; j < 32; j++)
+            r = (r << 8) | result.output_data[j];
+        // the memory was empty before the MSTORE
+        BOOST_CHECK(u256(0) == r);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(basicBlockGasTest)
+{
+    // The basic blocks are charged on entry, with the gas and the errors of the instructions
+    // PUSH1 03
+    // JUMPDEST <-------------+
+    // PUSH1 01 SWAP1 SUB     |
+    // DUP1 PUSH1 02 JUMPI ---+
+    // STOP
+    // 3 + 3 * (1 + 3 + 3 + 3 + 3 + 3 + 10) = 81 gas
+    dev::eth::EVMSchedule const& schedule = DefaultSchedule;
+    bytes code = fromHex("60035b600190038060025700");
+    bytes data = fromHex("");
+    Address destination{KeyPair::create().address()};
+    Address caller = destination;
+
+    evmc_result result =
+        evmc.execute(schedule, code, data, destination, caller, 0, 100, 0, false, false);
+    BOOST_CHECK(EVMC_SUCCESS == result.status_code);
+    BOOST_CHECK_EQUAL(result.gas_left, 19);
+    result = evmc.execute(schedule, code, data, destination, caller, 0, 81, 0, false, false);
+    BOOST_CHECK(EVMC_SUCCESS == result.status_code);
+    BOOST_CHECK_EQUAL(result.gas_left, 0);
+    result = evmc.execute(schedule, code, data, destination, caller, 0, 80, 0, false, false);
+    BOOST_CHECK(EVMC_OUT_OF_GAS == result.status_code);
+
+    // PUSH1 01 ADD, fails on the stack before the gas like one by one
+    code = fromHex("600101");
+    result = evmc.execute(schedule, code, data, destination, caller, 0, 100, 0, false, false);
+    BOOST_CHECK(EVMC_STACK_UNDERFLOW == result.status_code);
+    result = evmc.execute(schedule, code, data, destination, caller, 0, 4, 0, false, false);
+    BOOST_CHECK(EVMC_STACK_UNDERFLOW == result.status_code);
+}
+
 BOOST_AUTO_TEST_CASE(contractDeployTest)
 {
     /*
@@ -88,6 +88,7 @@ void checkParam(std::shared_ptr<LedgerParam> param)
     /// check state DB param
     BOOST_CHECK(param->mutableStorageParam().type == "sql");
     BOOST_CHECK(param->mutableStateParam().type == "mpt");
+    BOOST_CHECK(param->mutableStateParam().parallelThreads == 4);
 }
 /// test initConfig
 BOOST_AUTO_TEST_CASE(testInitConfig)
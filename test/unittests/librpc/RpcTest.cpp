@@ -344,6 +344,13 @@ BOOST_AUTO_TEST_CASE(testCall)
     BOOST_CHECK_THROW(rpc->call(invalidGroup, request), JsonRpcException);
 }
 
+BOOST_AUTO_TEST_CASE(testGetExecutionProfile)
+{
+    // the profiler is disabled by default
+    BOOST_CHECK_THROW(rpc->getExecutionProfile(groupId), JsonRpcException);
+    BOOST_CHECK_THROW(rpc->getExecutionProfile(invalidGroup), JsonRpcException);
+}
+
 BOOST_AUTO_TEST_CASE(testSendRawTransaction)
 {
     std::string rlpStr =
@@ -5,6 +5,7 @@
 #include <libblockverifier/ExecutiveContextFactory.h>
 #include <libdevcrypto/Common.h>
 #include <libethcore/ABI.h>
+#include <libethcore/ABICodec.h>
 #include <libstorage/CRUDPrecompiled.h>
 #include <libstorage/MemoryTable.h>
 #include <boost/test/unit_test.hpp>
@@ -50,6 +51,24 @@ BOOST_AUTO_TEST_CASE(call_add)
     bytes out = crudPrecompiled->call(context, bytesConstRef(&in));
 }
 
+BOOST_AUTO_TEST_CASE(conflictKeys)
+{
+    eth::ContractABI abi;
+    bytes in = abi.abiIn("select(string,string)", "t_test", "name");
+    auto keys = crudPrecompiled->conflictKeys(bytesConstRef(&in));
+    BOOST_TEST(keys.size() == 1u);
+    BOOST_TEST(keys[0].first == "t_test");
+    BOOST_TEST(keys[0].second == "name");
+
+    bytes params;
+    eth::ABICodec::encode(params, std::string("t_test"), std::vector<std::string>{"a", "b"});
+    in = abi.abiIn("selectBatch(string,string[])") + params;
+    keys = crudPrecompiled->conflictKeys(bytesConstRef(&in));
+    BOOST_TEST(keys.size() == 2u);
+    BOOST_TEST(keys[0].first == "t_test");
+    BOOST_TEST(keys[1].second == "b");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }  // namespace test_CRUDPrecompiled
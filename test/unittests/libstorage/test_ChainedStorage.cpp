@@ -0,0 +1,84 @@
+#include "MemoryStorage.h"
+#include <libdevcore/FixedHash.h>
+#include <libstorage/ChainedStorage.h>
+#include <libstorage/MemoryTableFactory.h>
+#include <libstorage/StorageException.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace dev;
+using namespace dev::storage;
+
+namespace test_ChainedStorage
+{
+struct ChainedStorageFixture
+{
+    ChainedStorageFixture()
+    {
+        memoryStorage = std::make_shared<MemoryStorage>();
+        parentFactory = std::make_shared<MemoryTableFactory>();
+        parentFactory->setStateStorage(memoryStorage);
+        parentFactory->createTable("t_test", "key", "value");
+        auto table = parentFactory->openTable("t_test");
+        auto entry = table->newEntry();
+        entry->setField("key", "name");
+        entry->setField("value", "Lili");
+        table->insert("name", entry);
+        entry = table->newEntry();
+        entry->setField("key", "name");
+        entry->setField("value", "Lucy");
+        table->insert("name", entry);
+        auto condition = table->newCondition();
+        condition->EQ("value", "Lucy");
+        table->remove("name", condition);
+    }
+
+    MemoryStorage::Ptr memoryStorage;
+    MemoryTableFactory::Ptr parentFactory;
+};
+
+BOOST_FIXTURE_TEST_SUITE(ChainedStorage, ChainedStorageFixture)
+
+BOOST_AUTO_TEST_CASE(select)
+{
+    auto snapshot = std::make_shared<dev::storage::ChainedStorage>(parentFactory, h256(0x0101), 1);
+    auto entries = snapshot->select(h256(), 1, "t_test", "name");
+    BOOST_TEST(entries->size() == 1u);
+    BOOST_TEST(entries->dirty() == false);
+    BOOST_TEST(entries->get(0)->dirty() == false);
+    BOOST_TEST(entries->get(0)->getField("value") == "Lili");
+    BOOST_TEST(entries->get(0)->getField("_num_") == "1");
+    BOOST_TEST(snapshot->select(h256(), 1, "t_test", "id")->size() == 0u);
+
+    // the block executed on the snapshot sees the table created by its parent
+    auto factory = std::make_shared<MemoryTableFactory>();
+    factory->setStateStorage(snapshot);
+    auto table = factory->openTable("t_test");
+    BOOST_TEST(table != nullptr);
+    auto entry = table->newEntry();
+    entry->setField("value", "Lily");
+    table->update("name", entry, table->newCondition());
+    BOOST_TEST(factory->dirtyTables().size() == 1u);
+    // the snapshot isn't modified
+    entries = snapshot->select(h256(), 1, "t_test", "name");
+    BOOST_TEST(entries->get(0)->getField("value") == "Lili");
+
+    BOOST_TEST(snapshot->commit(h256(0x0102), 2, factory->dirtyTables(), h256(0x0102)) == 1u);
+    entries = memoryStorage->select(h256(), 2, "t_test", "name");
+    BOOST_TEST(entries->get(0)->getField("value") == "Lily");
+}
+
+BOOST_AUTO_TEST_CASE(abort)
+{
+    auto snapshot = std::make_shared<dev::storage::ChainedStorage>(parentFactory, h256(0x0101), 1);
+    BOOST_TEST(snapshot->aborted() == false);
+    snapshot->abort();
+    BOOST_TEST(snapshot->aborted() == true);
+    BOOST_CHECK_THROW(snapshot->select(h256(), 1, "t_test", "name"), StorageException);
+    BOOST_CHECK_THROW(
+        snapshot->commit(h256(0x0102), 2, parentFactory->dirtyTables(), h256(0x0102)),
+        StorageException);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace test_ChainedStorage
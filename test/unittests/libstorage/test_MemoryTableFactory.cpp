@@ -100,6 +100,35 @@ BOOST_AUTO_TEST_CASE(open_Table)
     memoryDBFactory->commitDB(h256(0), 2);
 }
 
+BOOST_AUTO_TEST_CASE(access_Set)
+{
+    auto txFactory = std::make_shared<dev::storage::MemoryTableFactory>();
+    txFactory->setStateStorage(memoryDBFactory->stateStorage());
+    txFactory->setTrackAccess(true);
+    auto table = txFactory->createTable("t_test", "key", "value");
+    table->select("name", table->newCondition());
+    auto entry = table->newEntry();
+    entry->setField("key", "id");
+    entry->setField("value", "12345");
+    table->insert("id", entry);
+    BOOST_TEST(txFactory->readSet().size() == 3u);
+    BOOST_TEST(txFactory->readSet().count(std::make_pair(SYS_TABLES, std::string("t_test"))) == 1u);
+    BOOST_TEST(txFactory->writeSet().size() == 2u);
+    BOOST_TEST(txFactory->writeSet().count(
+                   std::make_pair(std::string("t_test"), std::string("id"))) == 1u);
+
+    memoryDBFactory->setTrackAccess(true);
+    memoryDBFactory->applyWrites(*txFactory);
+    BOOST_CHECK(memoryDBFactory->writeSet() == txFactory->writeSet());
+    auto appliedTable = memoryDBFactory->openTable("t_test");
+    BOOST_TEST(appliedTable != nullptr);
+    BOOST_TEST(appliedTable->select("id", appliedTable->newCondition())->size() == 1u);
+    BOOST_TEST(memoryDBFactory->hash() == txFactory->hash());
+    memoryDBFactory->clearAccessSet();
+    BOOST_TEST(memoryDBFactory->readSet().empty());
+    BOOST_TEST(memoryDBFactory->writeSet().empty());
+}
+
 BOOST_AUTO_TEST_CASE(open_sysTables)
 {
     auto table = memoryDBFactory->openTable(SYS_CURRENT_STATE);
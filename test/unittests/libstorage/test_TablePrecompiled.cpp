@@ -2,6 +2,7 @@
 #include "Common.h"
 #include <libdevcrypto/Common.h>
 #include <libethcore/ABI.h>
+#include <libethcore/ABICodec.h>
 #include <libstorage/ConditionPrecompiled.h>
 #include <libstorage/EntriesPrecompiled.h>
 #include <libstorage/EntryPrecompiled.h>
@@ -168,6 +169,50 @@ BOOST_AUTO_TEST_CASE(call_update2)
     BOOST_TEST(num == 0u);
 }
 
+BOOST_AUTO_TEST_CASE(call_batch)
+{
+    std::vector<std::string> keys{"name", "name2"};
+    std::vector<Address> entryAddresses;
+    for (auto const& key : keys)
+    {
+        auto entry = std::make_shared<storage::Entry>();
+        entry->setField("name", key);
+        auto entryPrecompiled = std::make_shared<EntryPrecompiled>();
+        entryPrecompiled->setEntry(entry);
+        entryAddresses.push_back(context->registerPrecompiled(entryPrecompiled));
+    }
+    eth::ContractABI abi;
+    bytes params;
+    eth::ABICodec::encode(params, keys, entryAddresses);
+    bytes in = abi.abiIn("insertBatch(string[],address[])") + params;
+    bytes out = tablePrecompiled->call(context, bytesConstRef(&in));
+    u256 num;
+    abi.abiOut(bytesConstRef(&out), num);
+    BOOST_TEST(num == 2u);
+
+    auto conditionPrecompiled = std::make_shared<ConditionPrecompiled>();
+    conditionPrecompiled->setCondition(std::make_shared<storage::Condition>());
+    Address conditionAddress = context->registerPrecompiled(conditionPrecompiled);
+    keys.push_back("name3");
+    eth::ABICodec::encode(params, keys, conditionAddress);
+    in = abi.abiIn("selectBatch(string[],address)") + params;
+    out = tablePrecompiled->call(context, bytesConstRef(&in));
+    Address entriesAddress;
+    abi.abiOut(bytesConstRef(&out), entriesAddress);
+    auto entriesPrecompiled =
+        std::dynamic_pointer_cast<EntriesPrecompiled>(context->getPrecompiled(entriesAddress));
+    auto entries = entriesPrecompiled->getEntries();
+    BOOST_TEST(entries->size() == 2u);
+    BOOST_TEST(entries->get(0)->getField("name") == "name");
+    BOOST_TEST(entries->get(1)->getField("name") == "name2");
+
+    // the keys without an entry are rejected
+    eth::ABICodec::encode(params, keys, entryAddresses);
+    in = abi.abiIn("insertBatch(string[],address[])") + params;
+    out = tablePrecompiled->call(context, bytesConstRef(&in));
+    BOOST_TEST(out.empty());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }  // namespace test_TablePrecompiled
@@ -24,6 +24,7 @@
 #include "libstoragestate/StorageState.h"
 #include "../libstorage/MemoryStorage.h"
 #include "libdevcore/SHA3.h"
+#include "libstorage/Common.h"
 #include "libstorage/MemoryTableFactory.h"
 #include <boost/test/unit_test.hpp>
 
@@ -89,6 +90,80 @@ BOOST_AUTO_TEST_CASE(Account)
     BOOST_TEST(nonce == u256(0));
 }
 
+BOOST_AUTO_TEST_CASE(AccountHeader)
+{
+    auto tableFactory = std::make_shared<dev::storage::MemoryTableFactory>();
+    tableFactory->setStateStorage(std::make_shared<dev::storage::MemoryStorage>());
+    m_state.setMemoryTableFactory(tableFactory);
+    m_state.setChainVersion(1);
+    Address addr1(0x100001);
+    m_state.addBalance(addr1, u256(10));
+    m_state.incNonce(addr1);
+    auto table = tableFactory->openTable("_contract_data_" + addr1.hex() + "_");
+    BOOST_TEST(table->data()->size() == 1u);
+    auto entries = table->select(dev::storagestate::ACCOUNT_HEADER, table->newCondition());
+    BOOST_TEST(entries->size() == 1u);
+    auto value = fromHex(entries->get(0)->getField(dev::storagestate::STORAGE_VALUE));
+    dev::storagestate::AccountHeader header(&value);
+    BOOST_TEST(header.balance == u256(10));
+    BOOST_TEST(header.nonce == u256(1));
+    BOOST_TEST(header.codeHash == EmptySHA3);
+    BOOST_TEST(header.alive == true);
+
+    auto savepoint = m_state.savepoint();
+    m_state.subBalance(addr1, u256(4));
+    BOOST_TEST(m_state.balance(addr1) == u256(6));
+    m_state.rollback(savepoint);
+    BOOST_TEST(m_state.balance(addr1) == u256(10));
+    m_state.commit();
+    BOOST_TEST(m_state.getNonce(addr1) == u256(1));
+}
+
+BOOST_AUTO_TEST_CASE(LegacyAccount)
+{
+    // the chains before version 1 keep a row per account field
+    auto tableFactory = std::make_shared<dev::storage::MemoryTableFactory>();
+    tableFactory->setStateStorage(std::make_shared<dev::storage::MemoryStorage>());
+    m_state.setMemoryTableFactory(tableFactory);
+    Address addr1(0x100001);
+    m_state.addBalance(addr1, u256(10));
+    m_state.incNonce(addr1);
+    auto table = tableFactory->openTable("_contract_data_" + addr1.hex() + "_");
+    BOOST_TEST(table->data()->size() == 5u);
+    BOOST_TEST(table->select(dev::storagestate::ACCOUNT_HEADER, table->newCondition())->size() ==
+               0u);
+    auto field = [&table](const char* _key) {
+        return table->select(_key, table->newCondition())
+            ->get(0)
+            ->getField(dev::storagestate::STORAGE_VALUE);
+    };
+    BOOST_TEST(field(dev::storagestate::ACCOUNT_BALANCE) == "10");
+    BOOST_TEST(field(dev::storagestate::ACCOUNT_NONCE) == "1");
+    BOOST_TEST(field(dev::storagestate::ACCOUNT_CODE_HASH) == toHex(EmptySHA3));
+    BOOST_TEST(field(dev::storagestate::ACCOUNT_CODE) == "");
+    BOOST_TEST(field(dev::storagestate::ACCOUNT_ALIVE) == "true");
+
+    std::string codeString("ccccccccccccc");
+    bytes code(codeString.begin(), codeString.end());
+    m_state.setCode(addr1, bytes(code));
+    BOOST_TEST(field(dev::storagestate::ACCOUNT_CODE) == toHex(code));
+    BOOST_TEST(field(dev::storagestate::ACCOUNT_CODE_HASH) == toHex(sha3(code)));
+    m_state.commit();
+
+    // a new StorageState reads the rows written by the older nodes
+    dev::storagestate::StorageState state(dev::u256(0));
+    state.setMemoryTableFactory(tableFactory);
+    BOOST_TEST(state.balance(addr1) == u256(10));
+    BOOST_TEST(state.getNonce(addr1) == u256(1));
+    BOOST_TEST(state.codeHash(addr1) == sha3(code));
+    BOOST_TEST(state.code(addr1) == code);
+    state.kill(addr1);
+    BOOST_TEST(field(dev::storagestate::ACCOUNT_BALANCE) == "0");
+    BOOST_TEST(field(dev::storagestate::ACCOUNT_CODE) == "");
+    BOOST_TEST(field(dev::storagestate::ACCOUNT_ALIVE) == "false");
+    BOOST_TEST(state.addressHasCode(addr1) == false);
+}
+
 BOOST_AUTO_TEST_CASE(Storage)
 {
     Address addr1(0x100001);
@@ -100,6 +175,18 @@ BOOST_AUTO_TEST_CASE(Storage)
     value = m_state.storage(addr1, u256(123));
     BOOST_TEST(value == u256(456));
     m_state.clearStorage(addr1);
+
+    // the cached slots follow the savepoints of the tables
+    auto savepoint = m_state.savepoint();
+    m_state.setStorage(addr1, u256(123), u256(789));
+    m_state.setStorage(addr1, u256(124), u256(1));
+    BOOST_TEST(m_state.storage(addr1, u256(123)) == u256(789));
+    m_state.rollback(savepoint);
+    BOOST_TEST(m_state.storage(addr1, u256(123)) == u256(456));
+    BOOST_TEST(m_state.storage(addr1, u256(124)) == u256());
+    m_state.setStorage(addr1, u256(124), u256(2));
+    m_state.commit();
+    BOOST_TEST(m_state.storage(addr1, u256(124)) == u256(2));
 }
 
 BOOST_AUTO_TEST_CASE(Code)
@@ -125,6 +212,63 @@ BOOST_AUTO_TEST_CASE(Code)
     BOOST_TEST(hasCode == true);
 }
 
+BOOST_AUTO_TEST_CASE(SharedCode)
+{
+    auto tableFactory = std::make_shared<dev::storage::MemoryTableFactory>();
+    tableFactory->setStateStorage(std::make_shared<dev::storage::MemoryStorage>());
+    m_state.setMemoryTableFactory(tableFactory);
+    m_state.setChainVersion(1);
+    Address addr1(0x100001);
+    Address addr2(0x100002);
+    std::string codeString("bbbbbbbbbbbbb");
+    bytes code(codeString.begin(), codeString.end());
+    m_state.addBalance(addr1, u256(10));
+    m_state.addBalance(addr2, u256(10));
+    m_state.setCode(addr1, bytes(code));
+    m_state.setCode(addr2, bytes(code));
+    auto table = tableFactory->openTable(dev::storage::SYS_HASH_2_CODE);
+    BOOST_TEST(table->data()->size() == 1u);
+    BOOST_TEST(m_state.codeHash(addr2) == sha3(code));
+
+    // a new StorageState of the same factory is served from the process-wide code cache
+    dev::storagestate::StorageState state(dev::u256(0));
+    state.setMemoryTableFactory(tableFactory);
+    state.setChainVersion(1);
+    BOOST_TEST(state.code(addr1) == code);
+    BOOST_TEST(state.code(addr2) == code);
+    dev::storagestate::CodeCache::instance().clear();
+    BOOST_TEST(state.code(addr1) == code);
+}
+
+BOOST_AUTO_TEST_CASE(AccountCodeRow)
+{
+    auto tableFactory = std::make_shared<dev::storage::MemoryTableFactory>();
+    tableFactory->setStateStorage(std::make_shared<dev::storage::MemoryStorage>());
+    m_state.setMemoryTableFactory(tableFactory);
+    m_state.setChainVersion(1);
+    Address addr1(0x100001);
+    m_state.addBalance(addr1, u256(10));
+
+    // code missing from the code table is read from the row of the account
+    std::string codeString("ddddddddddddd");
+    bytes code(codeString.begin(), codeString.end());
+    auto table = tableFactory->openTable("_contract_data_" + addr1.hex() + "_");
+    auto entry = table->newEntry();
+    entry->setField(dev::storagestate::STORAGE_KEY, dev::storagestate::ACCOUNT_CODE);
+    entry->setField(dev::storagestate::STORAGE_VALUE, toHex(code));
+    table->insert(dev::storagestate::ACCOUNT_CODE, entry);
+    dev::storagestate::AccountHeader header(u256(0), u256(10));
+    header.codeHash = sha3(code);
+    entry = table->newEntry();
+    entry->setField(dev::storagestate::STORAGE_VALUE, toHex(header.rlp()));
+    table->update(dev::storagestate::ACCOUNT_HEADER, entry, table->newCondition());
+    m_state.commit();
+
+    dev::storagestate::CodeCache::instance().clear();
+    BOOST_TEST(m_state.codeHash(addr1) == sha3(code));
+    BOOST_TEST(m_state.code(addr1) == code);
+}
+
 BOOST_AUTO_TEST_CASE(Nonce)
 {
     Address addr1(0x100001);
@@ -22,6 +22,8 @@
  */
 
 #include <libethcore/Transaction.h>
+#include <libstorage/ChainedStorage.h>
+#include <libstorage/MemoryTableFactory.h>
 #include <libsync/Common.h>
 #include <libsync/SyncMaster.h>
 #include <libsync/SyncMsgEngine.h>
@@ -36,11 +38,66 @@ using namespace dev;
 using namespace dev::eth;
 using namespace dev::sync;
 using namespace dev::blockverifier;
+using namespace dev::storage;
 
 namespace dev
 {
 namespace test
 {
+/// executes the next block on the snapshot of its parent, and records the block of each context
+class FakeChainedBlockVerifier : public FakeBlockverifier
+{
+public:
+    ExecutiveContext::Ptr executeBlock(Block& block, BlockInfo const&) override
+    {
+        return execute(block);
+    }
+    ChainedStorage::Ptr snapshotState(ExecutiveContext::Ptr, BlockInfo const& _blockInfo) override
+    {
+        return make_shared<ChainedStorage>(
+            make_shared<MemoryTableFactory>(), _blockInfo.hash, _blockInfo.number);
+    }
+    ExecutiveContext::Ptr executeChainedBlock(
+        Block& block, BlockInfo const&, ChainedStorage::Ptr) override
+    {
+        return execute(block);
+    }
+
+    map<ExecutiveContext::Ptr, h256> executedBlocks;
+
+private:
+    ExecutiveContext::Ptr execute(Block& block)
+    {
+        auto context = make_shared<ExecutiveContext>();
+        executedBlocks[context] = block.headerHash();
+        return context;
+    }
+};
+
+/// block chain on which otherPathBlock is committed by another path (like consensus) right after
+/// its parent, and which records the context each block is committed with
+class FakeRacingBlockChain : public FakeBlockChain
+{
+public:
+    using FakeBlockChain::FakeBlockChain;
+
+    CommitResult commitBlock(Block& block, ExecutiveContext::Ptr context) override
+    {
+        CommitResult ret = FakeBlockChain::commitBlock(block, context);
+        committedContexts[block.headerHash()] = context;
+        if (otherPathBlock && otherPathBlock->header().number() == number() + 1)
+        {
+            shared_ptr<Block> otherBlock = otherPathBlock;
+            otherPathBlock = nullptr;
+            FakeBlockChain::commitBlock(*otherBlock, nullptr);
+        }
+        return ret;
+    }
+
+    map<h256, ExecutiveContext::Ptr> committedContexts;
+    shared_ptr<Block> otherPathBlock;
+};
+
 class SyncFixture : public TestOutputHelperFixture
 {
 public:
@@ -322,6 +379,39 @@ BOOST_AUTO_TEST_CASE(MaintainDownloadingQueueTest)
     }
 }
 
+BOOST_AUTO_TEST_CASE(MaintainDownloadingQueueCommittedByOtherPathTest)
+{
+    int64_t latestNumber = 3;
+    Secret sec = dev::KeyPair::create().secret();
+    TxPoolFixture txpool_creator(1, 5, sec);
+    auto blockChain = make_shared<FakeRacingBlockChain>(1, 5, sec);
+    auto verifier = make_shared<FakeChainedBlockVerifier>();
+    m_genesisHash = blockChain->getBlockByNumber(0)->headerHash();
+    auto sync = make_shared<SyncMaster>(txpool_creator.m_topicService, txpool_creator.m_txPool,
+        blockChain, verifier, c_protocolId, NodeID(100), m_genesisHash);
+    std::shared_ptr<SyncMasterStatus> status = sync->syncStatus();
+
+    FakeBlockChain latestBlockChain(latestNumber + 1, 5, sec);
+    status->knownHighestNumber = latestNumber;
+    status->knownLatestHash = latestBlockChain.getBlockByNumber(latestNumber)->headerHash();
+
+    /// block 2 is executed on the snapshot of block 1, but committed by another path meanwhile
+    vector<shared_ptr<Block>> blocks;
+    for (int64_t i = 1; i <= latestNumber; ++i)
+        blocks.emplace_back(latestBlockChain.getBlockByNumber(i));
+    blockChain->otherPathBlock = latestBlockChain.getBlockByNumber(2);
+    status->bq().push(blocks);
+    status->bq().flushBufferToQueue();
+    BOOST_CHECK_EQUAL(sync->maintainDownloadingQueue(), true);  // finish
+    BOOST_CHECK_EQUAL(blockChain->number(), latestNumber);
+
+    /// block 3 is committed with its own context, not with the one executed for block 2
+    h256 const& hash = blockChain->getBlockByNumber(3)->headerHash();
+    BOOST_CHECK_EQUAL(hash, latestBlockChain.getBlockByNumber(3)->headerHash());
+    BOOST_REQUIRE(blockChain->committedContexts[hash] != nullptr);
+    BOOST_CHECK_EQUAL(verifier->executedBlocks[blockChain->committedContexts[hash]], hash);
+}
+
 BOOST_AUTO_TEST_CASE(DoWorkTest)
 {
     int64_t currentBlockNumber = 0;
@@ -101,6 +101,27 @@ BOOST_AUTO_TEST_CASE(SyncTransactionPacketTest)
     BOOST_CHECK_EQUAL(topTxs[0].sha3(), txPtr->sha3());
 }
 
+BOOST_AUTO_TEST_CASE(SyncTransactionPacketWithInvalidSignatureTest)
+{
+    auto txPacket = SyncTransactionsPacket();
+    auto txPtr1 = fakeSyncToolsSet.createTransaction(0);
+    auto txPtr2 = fakeSyncToolsSet.createTransaction(0);
+    auto txPtr3 = fakeSyncToolsSet.createTransaction(0);
+    // a valid signature whose r isn't the x coordinate of a curve point can't be recovered
+    SignatureStruct sig = txPtr2->signature();
+    txPtr2->updateSignature(SignatureStruct(h256(5), sig.s, sig.v));
+    bytes txRLPs = txPtr1->rlp() + txPtr2->rlp() + txPtr3->rlp();
+    txPacket.encode(0x03, txRLPs);
+    auto msgPtr = txPacket.toMessage(0x02);
+    auto fakeSessionPtr = fakeSyncToolsSet.createSession();
+    fakeMsgEngine.messageHandler(fakeException, fakeSessionPtr, msgPtr);
+
+    auto txPoolPtr = fakeSyncToolsSet.getTxPoolPtr();
+    auto topTxs = txPoolPtr->topTransactions(3);
+    BOOST_CHECK(topTxs.size() == 2);
+    BOOST_CHECK(txPoolPtr->pendingSize() == 2);
+}
+
 BOOST_AUTO_TEST_CASE(SyncBlocksPacketTest)
 {
     SyncBlocksPacket blocksPacket;
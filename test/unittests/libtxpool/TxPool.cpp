@@ -120,6 +120,14 @@ BOOST_AUTO_TEST_CASE(testImportAndSubmit)
     m_status = pool_test.m_txPool->status();
     BOOST_CHECK(m_status.current == 4);
     BOOST_CHECK(m_status.dropped == 1);
+    /// test pendingTransactions
+    h256s hashes{pending_list[1].sha3(), pending_list[0].sha3(), pending_list[2].sha3()};
+    Transactions pending_txs;
+    std::vector<size_t> missing = pool_test.m_txPool->pendingTransactions(hashes, pending_txs);
+    BOOST_CHECK(missing == std::vector<size_t>{1});
+    BOOST_CHECK(pending_txs.size() == 3);
+    BOOST_CHECK(pending_txs[0].sha3() == hashes[0]);
+    BOOST_CHECK(pending_txs[2].sha3() == hashes[2]);
 
     /// test topTransactions
     Transactions top_transactions = pool_test.m_txPool->topTransactions(20);
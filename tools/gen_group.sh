@@ -43,6 +43,11 @@ function generate_group_ini()
 consensusType=pbft
 ;the max number of transactions of a block
 maxTransNum=1000
+;broadcast the block header and the transaction hashes instead of the block in the prepare,
+;disable it until all the nodes of the group are upgraded
+compactPrepare=true
+;propose the next block before the current block is committed, needs the storage state
+pipeline=false
 ;the node id of leaders
 $nodeid_list
 
@@ -57,6 +62,19 @@ type=LevelDB
 [state]
 ;state type, now support mpt/storage
 type=${state_type}
+;threads executing transactions in parallel, 0 to disable,
+;only used by the storage state of the chains of version 1
+parallelThreads=0
+;threads executing the calls, 0 to execute them on the rpc threads
+callThreads=0
+;calls beyond it waiting or executing are rejected, 0 for no limit
+maxPendingCalls=1000
+;memory limit in MB of the call result cache, 0 to disable
+callCacheMB=0
+;the last executed blocks whose transactions are profiled, 0 to disable
+profileBlocks=0
+;log the costliest contracts every such profiled blocks, 0 to disable
+profileLogInterval=100
 
 
 
@@ -64,6 +82,9 @@ type=${state_type}
 [genesis]
 ;used to mark the genesis block of this group
 ;mark=${group_id}
+;version of the state layout and execution rules, only used to create the genesis block,
+;0 for the layout of the nodes before chain versions
+chainVersion=1
 
 ;txpool limit
 [txPool]